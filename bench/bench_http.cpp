@@ -0,0 +1,408 @@
+/**
+ * SPDX-FileComment: HTTP Load Benchmark
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file bench_http.cpp
+ * @brief Boots the server in-process on an ephemeral port and measures RPS and latency percentiles.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ *
+ * Usage:
+ *   bench_http [--connections 64] [--concurrency 4] [--duration 10] [--warmup 2]
+ *              [--routes /,/status,/system/health_check,/system/system_info]
+ *              [--server-threads N] [--transport tcp|unix] [--host 127.0.0.1 --port P]
+ *              [--unix /path/app.sock] [--output file.json]
+ *
+ * --connections  keep-alive connections (one request in flight each)
+ * --concurrency  client threads driving the connections via epoll
+ * --transport    in-process server on an ephemeral TCP port or on a Unix socket
+ * --port/--unix  benchmark an already running server instead of the in-process one
+ */
+
+#include "app.hpp"
+#include "controllers/home_controller.hpp"
+#include "controllers/system_controller.hpp"
+#include "controllers/static_controller.hpp"
+#include "rz_config.hpp"
+#include "services/database_service.hpp"
+#include "services/health_service.hpp"
+#include "utils/app_config.hpp"
+#include "utils/middleware_setup.hpp"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    unsigned connections = 64;
+    unsigned concurrency = 4;
+    unsigned duration_sec = 10;
+    unsigned warmup_sec = 2;
+    unsigned server_threads = 0;
+    std::string host = "127.0.0.1";
+    uint16_t port = 0; // 0 = boot in-process
+    bool unix_transport = false;
+    std::string unix_path; // Set = connect to this Unix socket instead of host:port
+    std::vector<std::string> routes{"/", "/status", "/system/health_check", "/system/system_info"};
+    std::string output;
+};
+
+struct Sample {
+    std::uint32_t route;
+    std::uint64_t latency_ns;
+};
+
+struct ThreadResult {
+    std::vector<Sample> samples;
+    std::uint64_t errors = 0;
+};
+
+struct Connection {
+    int fd = -1;
+    std::uint32_t route = 0;
+    std::string request;
+    std::size_t written = 0;
+    std::string buffer;
+    Clock::time_point sent;
+};
+
+[[noreturn]] void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " [--connections N] [--concurrency N] [--duration SEC] [--warmup SEC]"
+                 " [--routes a,b,c] [--server-threads N] [--transport tcp|unix] [--host H --port P]"
+                 " [--unix PATH] [--output FILE]\n";
+    std::exit(2);
+}
+
+Options parseArgs(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) usage(argv[0]);
+            return argv[++i];
+        };
+        if (arg == "--connections") opt.connections = std::stoul(next());
+        else if (arg == "--concurrency") opt.concurrency = std::stoul(next());
+        else if (arg == "--duration") opt.duration_sec = std::stoul(next());
+        else if (arg == "--warmup") opt.warmup_sec = std::stoul(next());
+        else if (arg == "--server-threads") opt.server_threads = std::stoul(next());
+        else if (arg == "--host") opt.host = next();
+        else if (arg == "--port") opt.port = static_cast<uint16_t>(std::stoul(next()));
+        else if (arg == "--unix") opt.unix_path = next();
+        else if (arg == "--transport") {
+            std::string transport = next();
+            if (transport != "tcp" && transport != "unix") usage(argv[0]);
+            opt.unix_transport = transport == "unix";
+        }
+        else if (arg == "--output") opt.output = next();
+        else if (arg == "--routes") {
+            opt.routes.clear();
+            std::string list = next();
+            std::size_t pos = 0;
+            while (pos <= list.size()) {
+                auto comma = list.find(',', pos);
+                std::string route = list.substr(pos, comma - pos);
+                if (!route.empty()) opt.routes.push_back(route);
+                if (comma == std::string::npos) break;
+                pos = comma + 1;
+            }
+        } else usage(argv[0]);
+    }
+    opt.connections = std::max(1u, opt.connections);
+    opt.concurrency = std::clamp(opt.concurrency, 1u, opt.connections);
+    if (opt.routes.empty()) usage(argv[0]);
+    if (!opt.unix_path.empty()) opt.unix_transport = true;
+    return opt;
+}
+
+int connectUnix(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int connectTo(const std::string& host, uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+// Returns the full response length once complete, 0 if more data is needed, -1 on error
+long responseLength(const std::string& buf) {
+    auto header_end = buf.find("\r\n\r\n");
+    if (header_end == std::string::npos) return 0;
+
+    std::size_t content_length = 0;
+    std::string_view headers(buf.data(), header_end);
+    std::size_t pos = 0;
+    while (pos < headers.size()) {
+        auto eol = headers.find("\r\n", pos);
+        std::string_view line = headers.substr(pos, eol == std::string_view::npos ? headers.npos : eol - pos);
+        if (line.size() > 15 && strncasecmp(line.data(), "content-length:", 15) == 0) {
+            content_length = std::strtoull(std::string(line.substr(15)).c_str(), nullptr, 10);
+        }
+        if (eol == std::string_view::npos) break;
+        pos = eol + 2;
+    }
+    std::size_t total = header_end + 4 + content_length;
+    return buf.size() >= total ? static_cast<long>(total) : 0;
+}
+
+void runClient(const Options& opt, uint16_t port, unsigned thread_index, unsigned connections,
+               const std::atomic<bool>& recording, const std::atomic<bool>& stop, ThreadResult& result) {
+    int ep = ::epoll_create1(EPOLL_CLOEXEC);
+    std::vector<Connection> conns(connections);
+    std::uint32_t next_route = thread_index;
+
+    auto sendNext = [&](Connection& c) {
+        c.route = next_route++ % opt.routes.size();
+        c.request = "GET " + opt.routes[c.route] + " HTTP/1.1\r\nHost: " + opt.host +
+                    "\r\nConnection: keep-alive\r\n\r\n";
+        c.written = 0;
+        c.buffer.clear();
+        c.sent = Clock::now();
+        ssize_t n = ::send(c.fd, c.request.data(), c.request.size(), MSG_NOSIGNAL);
+        if (n > 0) c.written = static_cast<std::size_t>(n);
+    };
+
+    for (std::size_t i = 0; i < conns.size(); ++i) {
+        conns[i].fd = opt.unix_path.empty() ? connectTo(opt.host, port) : connectUnix(opt.unix_path);
+        if (conns[i].fd < 0) {
+            ++result.errors;
+            continue;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = i;
+        ::epoll_ctl(ep, EPOLL_CTL_ADD, conns[i].fd, &ev);
+        sendNext(conns[i]);
+    }
+
+    std::vector<epoll_event> events(conns.size() + 1);
+    char chunk[16 * 1024];
+    while (!stop.load(std::memory_order_relaxed)) {
+        int n = ::epoll_wait(ep, events.data(), static_cast<int>(events.size()), 100);
+        for (int e = 0; e < n; ++e) {
+            Connection& c = conns[events[e].data.u64];
+            if (c.written < c.request.size()) { // rare: finish a partial write
+                ssize_t w = ::send(c.fd, c.request.data() + c.written, c.request.size() - c.written, MSG_NOSIGNAL);
+                if (w > 0) c.written += static_cast<std::size_t>(w);
+            }
+            ssize_t r = ::recv(c.fd, chunk, sizeof(chunk), 0);
+            if (r <= 0) {
+                if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+                ++result.errors;
+                ::epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+                ::close(c.fd);
+                c.fd = -1;
+                continue;
+            }
+            c.buffer.append(chunk, static_cast<std::size_t>(r));
+            long len = responseLength(c.buffer);
+            if (len == 0) continue;
+
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - c.sent).count();
+            bool ok = c.buffer.starts_with("HTTP/1.1 2") || c.buffer.starts_with("HTTP/1.1 3");
+            if (recording.load(std::memory_order_relaxed)) {
+                if (ok) result.samples.push_back({c.route, static_cast<std::uint64_t>(latency)});
+                else ++result.errors;
+            }
+            sendNext(c);
+        }
+    }
+
+    for (auto& c : conns) {
+        if (c.fd >= 0) ::close(c.fd);
+    }
+    ::close(ep);
+}
+
+nlohmann::json summarize(std::vector<std::uint64_t>& latencies, double seconds) {
+    nlohmann::json out;
+    out["requests"] = latencies.size();
+    out["rps"] = seconds > 0 ? static_cast<double>(latencies.size()) / seconds : 0.0;
+    if (latencies.empty()) return out;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) {
+        std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1));
+        return static_cast<double>(latencies[idx]) / 1000.0;
+    };
+    double sum = 0;
+    for (auto v : latencies) sum += static_cast<double>(v);
+
+    out["latency_us"] = {
+        {"p50", pct(0.50)},
+        {"p99", pct(0.99)},
+        {"p999", pct(0.999)},
+        {"max", static_cast<double>(latencies.back()) / 1000.0},
+        {"mean", sum / static_cast<double>(latencies.size()) / 1000.0},
+    };
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt = parseArgs(argc, argv);
+
+    // Keep all runtime data inside the build tree and the dependencies quiet
+    auto data_dir = std::filesystem::absolute(argv[0]).parent_path() / "bench_data";
+    std::filesystem::create_directories(data_dir);
+    ::setenv("DB_DIR", (data_dir / "bench.sqlite").c_str(), 0);
+    ::setenv("HEALTH_CHECK_SMTP", "false", 0);
+    spdlog::set_level(spdlog::level::warn);
+
+    rz::App app;
+    std::future<void> server;
+    uint16_t port = opt.port;
+    const bool in_process = opt.port == 0 && opt.unix_path.empty();
+
+    if (in_process) {
+        if (auto res = rz::services::DatabaseService::getInstance().init(); !res) {
+            std::cerr << "Database initialization failed: " << res.error() << std::endl;
+            return 1;
+        }
+        rz::services::HealthService::getInstance().start();
+        // Same middleware configuration as the server
+        rz::utils::MiddlewareSetup::configure();
+
+        rz::controllers::HomeController::registerRoutes(app);
+        rz::controllers::SystemController::registerRoutes(app);
+        rz::controllers::StaticController::registerRoutes(app);
+        rz::utils::MiddlewareSetup::configurePolicies();
+        app.loglevel(crow::LogLevel::Warning);
+
+        if (opt.unix_transport) {
+            opt.unix_path = (data_dir / "bench.sock").string();
+            std::filesystem::remove(opt.unix_path); // Left over by an aborted run
+            app.local_socket_path(opt.unix_path);
+        } else {
+            app.bindaddr("127.0.0.1").port(0);
+        }
+        auto& runner = app.multithreaded();
+        if (opt.server_threads > 0) runner.concurrency(static_cast<uint16_t>(opt.server_threads));
+        server = runner.run_async();
+        app.wait_for_server_start();
+        if (!opt.unix_transport) port = app.port();
+    }
+
+    std::atomic<bool> recording{false};
+    std::atomic<bool> stop{false};
+    std::vector<ThreadResult> results(opt.concurrency);
+    std::vector<std::thread> clients;
+    for (unsigned t = 0; t < opt.concurrency; ++t) {
+        unsigned share = opt.connections / opt.concurrency + (t < opt.connections % opt.concurrency ? 1 : 0);
+        results[t].samples.reserve(1 << 20);
+        clients.emplace_back(runClient, std::cref(opt), port, t, share, std::cref(recording), std::cref(stop),
+                             std::ref(results[t]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(opt.warmup_sec));
+    recording.store(true);
+    auto start = Clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(opt.duration_sec));
+    recording.store(false);
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    stop.store(true);
+    for (auto& c : clients) c.join();
+
+    if (in_process) {
+        app.stop();
+        server.get();
+        rz::services::HealthService::getInstance().stop();
+        if (opt.unix_transport) std::filesystem::remove(opt.unix_path);
+    }
+
+    // Aggregate
+    std::vector<std::uint64_t> all;
+    std::vector<std::vector<std::uint64_t>> per_route(opt.routes.size());
+    std::uint64_t errors = 0;
+    for (const auto& r : results) {
+        errors += r.errors;
+        for (const auto& s : r.samples) {
+            all.push_back(s.latency_ns);
+            per_route[s.route].push_back(s.latency_ns);
+        }
+    }
+
+    nlohmann::json report;
+    report["version"] = rz::config::VERSION;
+    report["compiler"] = rz::config::CMAKE_CXX_COMPILER;
+    report["target"] = in_process            ? "in-process"
+                       : opt.unix_transport ? opt.unix_path
+                                            : opt.host + ":" + std::to_string(opt.port);
+    report["transport"] = opt.unix_transport ? "unix" : "tcp";
+    report["connections"] = opt.connections;
+    report["concurrency"] = opt.concurrency;
+    report["duration_s"] = elapsed;
+    report["errors"] = errors;
+    report["total"] = summarize(all, elapsed);
+    for (std::size_t i = 0; i < opt.routes.size(); ++i) {
+        report["routes"][opt.routes[i]] = summarize(per_route[i], elapsed);
+    }
+
+    std::string text = report.dump(2);
+    if (opt.output.empty()) {
+        std::cout << text << std::endl;
+    } else {
+        std::ofstream(opt.output) << text << std::endl;
+    }
+    return errors > 0 && all.empty() ? 1 : 0;
+}
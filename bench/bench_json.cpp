@@ -0,0 +1,143 @@
+/**
+ * SPDX-FileComment: JSON Serialization Benchmark
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file bench_json.cpp
+ * @brief Compares rz::utils::JsonWriter with nlohmann::json DOM + dump() on response-sized documents.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ *
+ * Usage:
+ *   bench_json [--iterations 1000000]
+ *
+ * Reports ns and heap allocations per document for each serializer.
+ */
+
+#include "utils/json_writer.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+
+} // namespace
+
+// Counts every heap allocation of the process
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Check {
+    std::string name;
+    bool ok;
+    std::int64_t latency_us;
+    std::string detail;
+};
+
+// Shaped like the health check snapshot: nested objects, run-time keys, a string needing escapes
+const std::vector<Check> CHECKS{
+    {"database", true, 153, ""},
+    {"smtp", false, 2004, "connect to \"mail.example.com\":587 timed out\n"},
+    {"templates", true, 12, ""},
+    {"disk", true, 8, ""},
+};
+
+std::string withNlohmann() {
+    nlohmann::json response;
+    response["status"] = "degraded";
+    response["timestamp"] = "2026-10-18 08:00:00";
+    response["checks"] = nlohmann::json::object();
+    for (const auto& check : CHECKS) {
+        auto& entry = response["checks"][check.name];
+        entry["ok"] = check.ok;
+        entry["latency_us"] = check.latency_us;
+        if (!check.detail.empty()) entry["detail"] = check.detail;
+    }
+    return response.dump();
+}
+
+std::string withWriter() {
+    rz::utils::JsonWriter json(512);
+    json.beginObject()
+        .field<"status">("degraded")
+        .field<"timestamp">("2026-10-18 08:00:00")
+        .key<"checks">()
+        .beginObject();
+    for (const auto& check : CHECKS) {
+        json.key(check.name).beginObject().field<"ok">(check.ok).field<"latency_us">(check.latency_us);
+        if (!check.detail.empty()) json.field<"detail">(check.detail);
+        json.endObject();
+    }
+    json.endObject().endObject();
+    return json.take();
+}
+
+template <typename F>
+void run(std::string_view name, std::uint64_t iterations, F&& serialize) {
+    std::size_t bytes = 0;
+    for (std::uint64_t i = 0; i < iterations / 10; ++i) bytes += serialize().size(); // Warm-up
+
+    const auto allocations = g_allocations.load();
+    const auto start = Clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bytes += serialize().size();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    const auto allocated = g_allocations.load() - allocations;
+
+    std::cout << name << ": " << elapsed / iterations << " ns/doc, "
+              << static_cast<double>(allocated) / iterations << " allocations/doc"
+              << " (" << bytes % 10 << ")\n"; // Keeps the result alive
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t iterations = 1'000'000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::string_view(argv[i]) == "--iterations") {
+            iterations = std::strtoull(argv[i + 1], nullptr, 10);
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    if (iterations == 0) iterations = 1;
+
+    if (nlohmann::json::parse(withNlohmann()) != nlohmann::json::parse(withWriter())) {
+        std::cerr << "Serializers disagree:\n" << withNlohmann() << "\n" << withWriter() << "\n";
+        return 1;
+    }
+    std::cout << "Document (" << withWriter().size() << " bytes): " << withWriter() << "\n";
+
+    run("nlohmann::json", iterations, withNlohmann);
+    run("JsonWriter    ", iterations, withWriter);
+    return 0;
+}
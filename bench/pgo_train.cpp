@@ -0,0 +1,247 @@
+/**
+ * SPDX-FileComment: PGO Training Workload
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file pgo_train.cpp
+ * @brief Representative workload for profile-guided optimization (run against an RZ_PGO=GENERATE build).
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ *
+ * Usage:
+ *   pgo_train [--duration 20] [--threads 4]
+ *
+ * Boots the server in-process with the full middleware chain and drives it
+ * over keep-alive connections. Between requests every client thread also
+ * verifies JWTs, looks users up in SQLite and renders the email template, so
+ * the profile covers the paths that do not have a cheap HTTP trigger.
+ */
+
+#include "app.hpp"
+#include "controllers/home_controller.hpp"
+#include "controllers/system_controller.hpp"
+#include "controllers/static_controller.hpp"
+#include "services/database_service.hpp"
+#include "services/health_service.hpp"
+#include "services/smtp_service.hpp"
+#include "utils/middleware_setup.hpp"
+#include "utils/token_utils.hpp"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <future>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int USERS = 32;
+
+struct Counters {
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<std::uint64_t> tokens{0};
+    std::atomic<std::uint64_t> lookups{0};
+    std::atomic<std::uint64_t> renders{0};
+};
+
+// Mix of cheap cached routes, probes and a static miss; some requests ask for compression
+const std::vector<std::string> ROUTES{"/", "/status", "/system/health_check", "/system/system_info", "/metrics",
+                                      "/static/missing.css"};
+
+int connectLocal(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// Returns the full response length once complete, 0 if more data is needed
+std::size_t responseLength(const std::string& buf) {
+    auto header_end = buf.find("\r\n\r\n");
+    if (header_end == std::string::npos) return 0;
+    std::size_t content_length = 0;
+    std::size_t pos = 0;
+    while (pos < header_end) {
+        auto eol = buf.find("\r\n", pos);
+        if (eol - pos > 15 && strncasecmp(buf.data() + pos, "content-length:", 15) == 0) {
+            content_length = std::strtoull(buf.c_str() + pos + 15, nullptr, 10);
+        }
+        pos = eol + 2;
+    }
+    std::size_t total = header_end + 4 + content_length;
+    return buf.size() >= total ? total : 0;
+}
+
+bool roundTrip(int fd, const std::string& request, std::string& buffer) {
+    for (std::size_t sent = 0; sent < request.size();) {
+        ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<std::size_t>(n);
+    }
+    buffer.clear();
+    char chunk[16 * 1024];
+    while (responseLength(buffer) == 0) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer.append(chunk, static_cast<std::size_t>(n));
+    }
+    // 404 is expected for the static miss
+    return buffer.starts_with("HTTP/1.1 2") || buffer.starts_with("HTTP/1.1 3") ||
+           buffer.starts_with("HTTP/1.1 404");
+}
+
+void runClient(uint16_t port, unsigned index, const std::atomic<bool>& stop, Counters& counters) {
+    const std::string token = rz::utils::TokenUtils::generateToken(
+        std::format("pgo-user-{}", index % USERS), std::format("pgo-{}@example.com", index % USERS), index % 2 == 0);
+    auto& db = rz::services::DatabaseService::getInstance();
+    std::string buffer;
+    int fd = connectLocal(port);
+
+    for (std::uint64_t i = index; !stop.load(std::memory_order_relaxed); ++i) {
+        if (fd < 0 && (fd = connectLocal(port)) < 0) {
+            counters.errors.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        std::string request = std::format("GET {} HTTP/1.1\r\nHost: 127.0.0.1\r\n", ROUTES[i % ROUTES.size()]);
+        if (i % 3 == 0) request += "Accept-Encoding: gzip, deflate, br, zstd\r\n";
+        if (i % 5 == 0) request += "Authorization: Bearer " + token + "\r\n";
+        request += "Connection: keep-alive\r\n\r\n";
+        if (roundTrip(fd, request, buffer)) {
+            counters.requests.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            counters.errors.fetch_add(1, std::memory_order_relaxed);
+            ::close(fd);
+            fd = -1;
+        }
+
+        if (i % 4 == 0) {
+            if (rz::utils::TokenUtils::verifyToken(token)) counters.tokens.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (i % 8 == 0) {
+            const std::string uuid = std::format("pgo-user-{}", i % USERS);
+            if (db.getUser(uuid) && db.getNotificationConfig(uuid)) {
+                counters.lookups.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (i % 64 == 0) {
+            nlohmann::json data{{"subject", "Training"}, {"title", "PGO"}, {"name", "User"},
+                                {"app_name", "CPPAppServer"}, {"message", "Profile run"},
+                                {"has_link", i % 128 == 0}, {"link_url", "https://example.com"},
+                                {"link_text", "Open"}};
+            if (rz::services::SmtpService::renderBody(i % 128 == 0 ? "de" : "en", data)) {
+                counters.renders.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    if (fd >= 0) ::close(fd);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned duration_sec = 20;
+    unsigned threads = 4;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view arg = argv[i];
+        if (arg == "--duration") duration_sec = std::stoul(argv[i + 1]);
+        else if (arg == "--threads") threads = std::max(1u, static_cast<unsigned>(std::stoul(argv[i + 1])));
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--duration SEC] [--threads N]\n";
+            return 2;
+        }
+    }
+
+    // Keep all runtime data inside the build tree and the dependencies quiet
+    auto data_dir = std::filesystem::absolute(argv[0]).parent_path() / "pgo_data";
+    std::filesystem::create_directories(data_dir);
+    ::setenv("DB_DIR", (data_dir / "train.sqlite").c_str(), 0);
+    ::setenv("MAIL_TEMPLATE_DIR", RZ_TEMPLATE_DIR, 0);
+    ::setenv("HEALTH_CHECK_SMTP", "false", 0);
+    ::setenv("SERVER_JWT_SECRET", "pgo-training-secret", 0);
+    spdlog::set_level(spdlog::level::warn);
+
+    auto& db = rz::services::DatabaseService::getInstance();
+    if (auto res = db.init(); !res) {
+        std::cerr << "Database initialization failed: " << res.error() << std::endl;
+        return 1;
+    }
+    for (int u = 0; u < USERS; ++u) {
+        // E-mail addresses are unique across all shards
+        rz::services::User user{std::format("pgo-user-{}", u), std::format("User {}", u),
+                                std::format("pgo-{}@example.com", u)};
+        rz::services::NotificationConfig config{user.uuid, true, true, u % 2 == 0, u % 2 == 0 ? "en" : "de"};
+        if (auto res = db.createOrUpdateUser(user, config); !res) {
+            std::cerr << "Seeding users failed: " << res.error() << std::endl;
+            return 1;
+        }
+    }
+    rz::services::HealthService::getInstance().start();
+    rz::utils::MiddlewareSetup::configure();
+
+    // Same middleware chain and route set as the server
+    rz::App app;
+    rz::controllers::HomeController::registerRoutes(app);
+    rz::controllers::SystemController::registerRoutes(app);
+    rz::controllers::StaticController::registerRoutes(app);
+    rz::utils::MiddlewareSetup::configurePolicies();
+    app.loglevel(crow::LogLevel::Warning);
+
+    auto server = app.bindaddr("127.0.0.1").port(0).multithreaded().run_async();
+    app.wait_for_server_start();
+
+    Counters counters;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> clients;
+    for (unsigned t = 0; t < threads; ++t) {
+        clients.emplace_back(runClient, app.port(), t, std::cref(stop), std::ref(counters));
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(duration_sec));
+    stop.store(true);
+    for (auto& c : clients) c.join();
+
+    app.stop();
+    server.get();
+    rz::services::HealthService::getInstance().stop();
+
+    std::cout << std::format("pgo_train: {} requests ({} errors), {} token verifications, {} user lookups, "
+                             "{} template renders in {} s\n",
+                             counters.requests.load(), counters.errors.load(), counters.tokens.load(),
+                             counters.lookups.load(), counters.renders.load(), duration_sec);
+    return counters.requests.load() > 0 ? 0 : 1;
+}
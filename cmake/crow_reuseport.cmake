@@ -0,0 +1,47 @@
+# file: cmake/crow_reuseport.cmake
+# brief: Patch step for the fetched Crow sources: enable SO_REUSEPORT on the
+#        listening socket when RZ_SO_REUSEPORT=1 is set in the environment
+#        (set by the prefork supervisor before forking the workers).
+# version: 0.1.0
+# date: 2026-10-18
+# author: ZHENG Robert
+#
+# usage: cmake -DCROW_SOURCE_DIR=<dir> -P crow_reuseport.cmake
+#
+# The script is idempotent and leaves a marker file (rz_reuseport.patched)
+# in the Crow source directory, which CMakeLists.txt uses to enable the
+# prefork mode at compile time.
+
+if(NOT CROW_SOURCE_DIR)
+    message(FATAL_ERROR "CROW_SOURCE_DIR not set")
+endif()
+
+set(_marker "${CROW_SOURCE_DIR}/rz_reuseport.patched")
+if(EXISTS "${_marker}")
+    return()
+endif()
+
+set(_inject "if (const char* rz_rp = std::getenv(\"RZ_SO_REUSEPORT\"); rz_rp && rz_rp[0] == '1') { int rz_on = 1; ::setsockopt(\\1.native_handle(), SOL_SOCKET, SO_REUSEPORT, &rz_on, sizeof(rz_on)); }")
+
+file(GLOB_RECURSE _headers "${CROW_SOURCE_DIR}/include/crow/*.h")
+set(_patched FALSE)
+foreach(_header IN LISTS _headers)
+    file(READ "${_header}" _content)
+    # Match "<acceptor expr>.set_option(<...reuse_address...>);" and append the injected option
+    string(REGEX MATCH "([A-Za-z_][A-Za-z0-9_\\.\\(\\)]*)\\.set_option\\(([^;]*)reuse_address([^;]*)\\);" _match "${_content}")
+    if(_match)
+        string(REGEX REPLACE
+            "([A-Za-z_][A-Za-z0-9_\\.\\(\\)]*)\\.set_option\\(([^;]*)reuse_address([^;]*)\\);"
+            "\\0 ${_inject}"
+            _content "${_content}")
+        file(WRITE "${_header}" "${_content}")
+        message(STATUS "Crow: SO_REUSEPORT patch applied to ${_header}")
+        set(_patched TRUE)
+    endif()
+endforeach()
+
+if(_patched)
+    file(WRITE "${_marker}" "SO_REUSEPORT patch applied\n")
+else()
+    message(WARNING "Crow: no reuse_address option found, SO_REUSEPORT patch not applied (prefork mode disabled)")
+endif()
@@ -0,0 +1,96 @@
+# file: cmake/crow_sendfile.cmake
+# brief: Patch step for the fetched Crow sources: send static file bodies
+#        (crow::response::set_static_file_info*) with sendfile(2) instead of
+#        reading them through a 16 KiB user-space buffer.
+# version: 0.1.0
+# date: 2026-10-18
+# author: ZHENG Robert
+#
+# usage: cmake -DCROW_SOURCE_DIR=<dir> -P crow_sendfile.cmake
+#
+# Only plain stream sockets (TCP, Unix) take the fast path; TLS streams keep
+# Crow's buffered loop. The script is idempotent and leaves a marker file
+# (rz_sendfile.patched) in the Crow source directory, which CMakeLists.txt
+# turns into the RZ_HAVE_SENDFILE compile definition.
+
+if(NOT CROW_SOURCE_DIR)
+    message(FATAL_ERROR "CROW_SOURCE_DIR not set")
+endif()
+
+set(_marker "${CROW_SOURCE_DIR}/rz_sendfile.patched")
+if(EXISTS "${_marker}")
+    return()
+endif()
+
+set(_header "${CROW_SOURCE_DIR}/include/crow/http_connection.h")
+if(NOT EXISTS "${_header}")
+    message(WARNING "Crow: ${_header} not found, sendfile patch not applied")
+    return()
+endif()
+file(READ "${_header}" _content)
+
+set(_function "void do_write_static()")
+set(_branch "if (res.file_info.statResult == 0)")
+string(FIND "${_content}" "${_function}" _function_pos)
+if(_function_pos EQUAL -1)
+    message(WARNING "Crow: do_write_static() not found, sendfile patch not applied")
+    return()
+endif()
+string(SUBSTRING "${_content}" ${_function_pos} -1 _tail)
+string(FIND "${_tail}" "${_branch}" _branch_offset)
+if(_branch_offset EQUAL -1)
+    message(WARNING "Crow: static file branch not found, sendfile patch not applied")
+    return()
+endif()
+math(EXPR _branch_pos "${_function_pos} + ${_branch_offset}")
+
+# Helpers live in the connection class, so "asio" resolves to Crow's own alias
+# (standalone or Boost). The generic overload keeps TLS streams on the old path.
+set(_helpers [=[template<typename Protocol, typename Executor>
+        static bool rz_send_file(asio::basic_stream_socket<Protocol, Executor>& socket, const std::string& path, off_t size)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            off_t offset = 0;
+            while (offset < size)
+            {
+                ssize_t sent = ::sendfile(socket.native_handle(), fd, &offset, static_cast<size_t>(size - offset));
+                if (sent > 0) continue;
+                if (sent < 0 && errno == EINTR) continue;
+                if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    // Asio keeps the descriptor non-blocking; wait like a blocking write would
+                    pollfd pfd{socket.native_handle(), POLLOUT, 0};
+                    if (::poll(&pfd, 1, 30000) > 0) continue;
+                }
+                break;
+            }
+            ::close(fd);
+            return offset > 0 || size == 0;
+        }
+
+        template<typename Stream>
+        static bool rz_send_file(Stream&, const std::string&, off_t)
+        {
+            return false;
+        }
+
+        ]=])
+set(_fast_path [=[if (res.file_info.statResult == 0 && rz_send_file(adaptor_.socket(), res.file_info.path, res.file_info.statbuf.st_size))
+            {
+                res.file_info.statResult = -1; // body already written with sendfile(2)
+            }
+            ]=])
+
+string(SUBSTRING "${_content}" 0 ${_function_pos} _before)
+math(EXPR _body_len "${_branch_pos} - ${_function_pos}")
+string(SUBSTRING "${_content}" ${_function_pos} ${_body_len} _function_head)
+string(SUBSTRING "${_content}" ${_branch_pos} -1 _after)
+set(_content "${_before}${_helpers}${_function_head}${_fast_path}${_after}")
+
+# System headers for sendfile/poll, right after the include guard
+string(REPLACE "#pragma once" "#pragma once\n#include <cerrno>\n#include <fcntl.h>\n#include <poll.h>\n#include <sys/sendfile.h>\n#include <unistd.h>" _content "${_content}")
+
+file(WRITE "${_header}" "${_content}")
+file(WRITE "${_marker}" "sendfile patch applied\n")
+message(STATUS "Crow: sendfile patch applied to ${_header}")
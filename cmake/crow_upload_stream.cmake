@@ -0,0 +1,108 @@
+# file: cmake/crow_upload_stream.cmake
+# brief: Patch step for the fetched Crow sources: let the request parser hand
+#        body bytes to rz::utils::upload_hooks instead of appending them to
+#        crow::request::body, so uploads stream to disk as they arrive.
+# version: 0.1.1
+# date: 2026-10-18
+# author: ZHENG Robert
+#
+# usage: cmake -DCROW_SOURCE_DIR=<dir> -P crow_upload_stream.cmake
+#
+# The hooks only claim requests to /api/uploads/, every other request is
+# parsed as before. The connection gets two additions: a writer for the 413
+# sent when a body exceeds the limit (the failed parse then closes the
+# socket), and a destructor hook that drops the state of an upload the client
+# abandoned. The script is idempotent and leaves a marker file
+# (rz_upload_stream.patched) in the Crow source directory, which
+# CMakeLists.txt turns into the RZ_HAVE_UPLOAD_STREAM compile definition.
+
+if(NOT CROW_SOURCE_DIR)
+    message(FATAL_ERROR "CROW_SOURCE_DIR not set")
+endif()
+
+set(_marker "${CROW_SOURCE_DIR}/rz_upload_stream.patched")
+if(EXISTS "${_marker}")
+    return()
+endif()
+
+set(_header "${CROW_SOURCE_DIR}/include/crow/parser.h")
+set(_connection_header "${CROW_SOURCE_DIR}/include/crow/http_connection.h")
+foreach(_file IN ITEMS "${_header}" "${_connection_header}")
+    if(NOT EXISTS "${_file}")
+        message(WARNING "Crow: ${_file} not found, upload stream patch not applied")
+        return()
+    endif()
+endforeach()
+file(READ "${_header}" _content)
+
+set(_ident "([A-Za-z_][A-Za-z0-9_]*)")
+set(_open "\\)[ \t\r\n]*\\{")
+set(_data_args "http_parser\\* ${_ident}, const char\\* ${_ident}, size_t ${_ident}")
+set(_hooks "::rz::utils::upload_hooks")
+
+# Appends an injected statement (\1.. = parameter names) to the opening brace of a callback.
+# All or nothing: a partially hooked parser would lose request bodies.
+function(rz_hook_callback regex inject)
+    string(REGEX MATCH "${regex}" _match "${_content}")
+    if(NOT _match)
+        message(WARNING "Crow: parser callback not found (${regex}), upload stream patch not applied")
+        set(_failed TRUE PARENT_SCOPE)
+        return()
+    endif()
+    string(REGEX REPLACE "${regex}" "\\0 ${inject}" _patched "${_content}")
+    set(_content "${_patched}" PARENT_SCOPE)
+endfunction()
+
+set(_failed FALSE)
+rz_hook_callback("static int on_url\\(${_data_args}${_open}" "${_hooks}::onUrl(\\1, \\2, \\3);")
+rz_hook_callback("static int on_header_field\\(${_data_args}${_open}" "${_hooks}::onHeaderField(\\1, \\2, \\3);")
+rz_hook_callback("static int on_header_value\\(${_data_args}${_open}" "${_hooks}::onHeaderValue(\\1, \\2, \\3);")
+rz_hook_callback("static int on_headers_complete\\(http_parser\\* ${_ident}${_open}"
+                 "${_hooks}::onHeadersComplete(\\1, \\1->method, \\1->content_length);")
+rz_hook_callback("static int on_body\\(${_data_args}${_open}"
+                 "if (int rz_action = ${_hooks}::onBody(\\1, \\2, \\3)) { if (rz_action < 0) static_cast<HTTPParser*>(\\1)->handler_->rz_reject_body(${_hooks}::rejection()); return rz_action > 0 ? 0 : -1; }")
+rz_hook_callback("static int on_message_complete\\(http_parser\\* ${_ident}${_open}" "${_hooks}::onMessageComplete(\\1);")
+if(_failed)
+    return()
+endif()
+
+set(_declarations [=[#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+namespace rz::utils::upload_hooks {
+void onUrl(const void* parser, const char* at, std::size_t length);
+void onHeaderField(const void* parser, const char* at, std::size_t length);
+void onHeaderValue(const void* parser, const char* at, std::size_t length);
+void onHeadersComplete(const void* parser, unsigned int method, std::uint64_t content_length);
+int onBody(const void* parser, const char* at, std::size_t length);
+void onMessageComplete(const void* parser);
+void onClose(const void* parser);
+const std::string& rejection();
+} // namespace rz::utils::upload_hooks]=])
+string(REPLACE "#pragma once" "${_declarations}" _content "${_content}")
+
+# Connection: the 413 writer goes in front of the destructor, the close hook into it.
+# Same parser address as the callbacks see (HTTPParser derives from http_parser only).
+file(READ "${_connection_header}" _connection)
+set(_destructor "~Connection\\(\\)[ \t\r\n]*\\{")
+string(REGEX MATCH "${_destructor}" _match "${_connection}")
+if(NOT _match)
+    message(WARNING "Crow: connection destructor not found, upload stream patch not applied")
+    return()
+endif()
+set(_writer [=[void rz_reject_body(const std::string& response)
+        {
+            // A few hundred bytes: a blocking write is fine, the failed parse closes the socket next
+            error_code ec;
+            asio::write(adaptor_.socket(), asio::buffer(response), ec);
+        }
+
+        ]=])
+string(REGEX REPLACE "${_destructor}" "${_writer}\\0 ${_hooks}::onClose(static_cast<const http_parser*>(&parser_));"
+       _connection "${_connection}")
+
+file(WRITE "${_header}" "${_content}")
+file(WRITE "${_connection_header}" "${_connection}")
+file(WRITE "${_marker}" "upload stream patch applied\n")
+message(STATUS "Crow: upload stream patch applied to ${_header}")
@@ -0,0 +1,43 @@
+/**
+ * SPDX-FileComment: Application Type
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file app.hpp
+ * @brief The Crow application type including the global middleware chain.
+ * @version 0.1.5
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <crow.h>
+#include "middleware/admission_middleware.hpp"
+#include "middleware/arena_middleware.hpp"
+#include "middleware/bulkhead_middleware.hpp"
+#include "middleware/compression_middleware.hpp"
+#include "middleware/metrics_middleware.hpp"
+#include "middleware/rate_limit_middleware.hpp"
+#include "middleware/tracing_middleware.hpp"
+
+namespace rz {
+
+/**
+ * @brief Crow application with all global middlewares, in execution order.
+ */
+using App = crow::App<rz::middleware::ArenaMiddleware,
+                      rz::middleware::MetricsMiddleware,
+                      rz::middleware::TracingMiddleware,
+                      rz::middleware::RateLimitMiddleware,
+                      rz::middleware::BulkheadMiddleware,
+                      rz::middleware::AdmissionMiddleware,
+                      rz::middleware::CompressionMiddleware>;
+
+} // namespace rz
@@ -0,0 +1,37 @@
+/**
+ * SPDX-FileComment: Event Controller Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file event_controller.hpp
+ * @brief Controller for the Server-Sent Events stream.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "app.hpp"
+
+namespace rz::controllers {
+
+/**
+ * @brief Controller handling /api/events/stream.
+ */
+class EventController {
+public:
+    /**
+     * @brief Configures the EventHub and registers the stream route.
+     * @param app Reference to the Crow application.
+     */
+    static void registerRoutes(rz::App& app);
+};
+
+} // namespace rz::controllers
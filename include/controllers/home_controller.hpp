@@ -7,8 +7,8 @@
  *
  * @file home_controller.hpp
  * @brief Controller for handling home/root routes.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.1
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -18,7 +18,7 @@
 
 #pragma once
 
-#include <crow.h>
+#include "app.hpp"
 
 namespace rz::controllers {
 
@@ -31,7 +31,7 @@ public:
      * @brief Registers routes associated with this controller to the Crow app.
      * @param app Reference to the Crow application.
      */
-    static void registerRoutes(crow::SimpleApp& app);
+    static void registerRoutes(rz::App& app);
 };
 
 } // namespace rz::controllers
@@ -0,0 +1,37 @@
+/**
+ * SPDX-FileComment: Push Controller Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file push_controller.hpp
+ * @brief Controller for the WebSocket push channel.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "app.hpp"
+
+namespace rz::controllers {
+
+/**
+ * @brief Controller handling the /api/push WebSocket endpoint.
+ */
+class PushController {
+public:
+    /**
+     * @brief Registers the WebSocket route to the Crow app.
+     * @param app Reference to the Crow application.
+     */
+    static void registerRoutes(rz::App& app);
+};
+
+} // namespace rz::controllers
@@ -0,0 +1,37 @@
+/**
+ * SPDX-FileComment: Static Controller Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file static_controller.hpp
+ * @brief Controller serving static assets below /static.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "app.hpp"
+
+namespace rz::controllers {
+
+/**
+ * @brief Controller handling /static/<path> (public, whitelisted by AuthMiddleware).
+ */
+class StaticController {
+public:
+    /**
+     * @brief Configures the StaticFileService and registers the static route.
+     * @param app Reference to the Crow application.
+     */
+    static void registerRoutes(rz::App& app);
+};
+
+} // namespace rz::controllers
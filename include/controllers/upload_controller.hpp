@@ -0,0 +1,37 @@
+/**
+ * SPDX-FileComment: Upload Controller Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file upload_controller.hpp
+ * @brief Controller for streaming file uploads below /api/uploads.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "app.hpp"
+
+namespace rz::controllers {
+
+/**
+ * @brief Controller handling POST/PUT /api/uploads/<name>.
+ */
+class UploadController {
+public:
+    /**
+     * @brief Prepares UPLOAD_DIR and registers the upload route.
+     * @param app Reference to the Crow application.
+     */
+    static void registerRoutes(rz::App& app);
+};
+
+} // namespace rz::controllers
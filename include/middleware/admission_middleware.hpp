@@ -0,0 +1,59 @@
+/**
+ * @file admission_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Admission Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "utils/admission_controller.hpp"
+#include "utils/route_registry.hpp"
+#include <chrono>
+#include <string>
+
+namespace rz {
+namespace middleware {
+
+struct AdmissionMiddleware {
+  // Context remembers whether the request holds an admission slot
+  struct context {
+    bool admitted = false;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    auto &admission = rz::utils::AdmissionController::getInstance();
+    if (!admission.enabled() ||
+        admission.exempt(rz::utils::RouteRegistry::getInstance().match(req.url))) {
+      return;
+    }
+
+    if (!admission.tryAcquire()) {
+      // Shed before the handler runs; the client backs off instead of queueing
+      res.code = 503;
+      res.set_header("Retry-After", std::to_string(admission.retryAfter()));
+      res.body = "Service Unavailable: server is overloaded.";
+      res.end();
+      return;
+    }
+    ctx.admitted = true;
+    ctx.start = std::chrono::steady_clock::now();
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    if (ctx.admitted) {
+      ctx.admitted = false;
+      rz::utils::AdmissionController::getInstance().release(
+          std::chrono::steady_clock::now() - ctx.start);
+    }
+  }
+};
+
+} // namespace middleware
+} // namespace rz
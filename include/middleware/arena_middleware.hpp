@@ -0,0 +1,34 @@
+/**
+ * @file arena_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Arena Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "utils/request_arena.hpp"
+
+namespace rz {
+namespace middleware {
+
+struct ArenaMiddleware {
+  struct context {};
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    // no-op
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    // First in the chain, so this runs after every other after_handle
+    rz::utils::RequestArena::reset();
+  }
+};
+
+} // namespace middleware
+} // namespace rz
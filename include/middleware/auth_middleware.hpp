@@ -2,8 +2,8 @@
  * @file auth_middleware.hpp
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @brief Auth Middleware
- * @version 0.15.0
- * @date 2026-01-24
+ * @version 0.15.1
+ * @date 2026-10-18
  *
  * @copyright Copyright (c) 2026 ZHENG Robert
  *
@@ -13,6 +13,7 @@
 #pragma once
 #include "crow.h"
 #include "utils/token_utils.hpp"
+#include "utils/trace.hpp"
 #include <string>
 
 namespace rz {
@@ -54,7 +55,11 @@ struct AuthMiddleware {
 
     // 4. Verify
     // CORRECTION: 'token' is already std::string, no conversion needed!
-    auto payload = rz::utils::TokenUtils::verifyToken(token);
+    std::optional<rz::utils::TokenPayload> payload;
+    {
+      rz::utils::TraceSpan span("auth.verify_jwt");
+      payload = rz::utils::TokenUtils::verifyToken(token);
+    }
 
     if (!payload) {
       res.code = 403;
@@ -0,0 +1,54 @@
+/**
+ * @file bulkhead_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Bulkhead Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "services/metrics_service.hpp"
+#include "utils/route_registry.hpp"
+
+namespace rz {
+namespace middleware {
+
+struct BulkheadMiddleware {
+  // Context holds the bulkhead slot taken by the request, if any
+  struct context {
+    rz::utils::Bulkhead *bulkhead = nullptr;
+  };
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    auto *bulkhead = rz::utils::RouteRegistry::getInstance().match(req.url).bulkhead;
+    if (!bulkhead) {
+      return;
+    }
+
+    if (!bulkhead->tryEnter()) {
+      // Fail fast: a saturated slow route must not occupy another I/O thread
+      rz::services::MetricsService::getInstance().increment(bulkhead->rejected_series);
+      res.code = 503;
+      res.set_header("Retry-After", "1");
+      res.body = "Service Unavailable: route is at capacity.";
+      res.end();
+      return;
+    }
+    ctx.bulkhead = bulkhead;
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    if (ctx.bulkhead) {
+      ctx.bulkhead->leave();
+      ctx.bulkhead = nullptr;
+    }
+  }
+};
+
+} // namespace middleware
+} // namespace rz
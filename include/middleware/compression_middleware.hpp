@@ -0,0 +1,34 @@
+/**
+ * @file compression_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Compression Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "services/compression_service.hpp"
+
+namespace rz {
+namespace middleware {
+
+struct CompressionMiddleware {
+  struct context {};
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    // no-op
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    // Last in the chain, so this runs first: right after the handler produced the body
+    rz::services::CompressionService::getInstance().apply(req, res);
+  }
+};
+
+} // namespace middleware
+} // namespace rz
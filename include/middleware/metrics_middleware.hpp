@@ -0,0 +1,50 @@
+/**
+ * @file metrics_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Metrics Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "services/metrics_service.hpp"
+#include "utils/route_registry.hpp"
+#include <chrono>
+
+namespace rz {
+namespace middleware {
+
+struct MetricsMiddleware {
+  // Context keeps the start time and the resolved route of the request
+  struct context {
+    const rz::utils::RouteInfo *route = nullptr;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    ctx.start = std::chrono::steady_clock::now();
+    ctx.route = &rz::utils::RouteRegistry::getInstance().match(req.url);
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    if (!ctx.route) {
+      return;
+    }
+    auto &metrics = rz::services::MetricsService::getInstance();
+    metrics.observe(ctx.route->latency_series,
+                    std::chrono::steady_clock::now() - ctx.start);
+
+    int status_class = res.code / 100;
+    if (status_class >= 1 && status_class <= 5) {
+      metrics.increment(ctx.route->response_series[status_class - 1]);
+    }
+  }
+};
+
+} // namespace middleware
+} // namespace rz
@@ -0,0 +1,48 @@
+/**
+ * @file rate_limit_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Rate Limit Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "utils/rate_limiter.hpp"
+#include "utils/route_registry.hpp"
+#include <string>
+
+namespace rz {
+namespace middleware {
+
+struct RateLimitMiddleware {
+  struct context {};
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    auto &limiter = rz::utils::RateLimiter::getInstance();
+    if (!limiter.enabled()) {
+      return;
+    }
+
+    const auto &route = rz::utils::RouteRegistry::getInstance().match(req.url);
+    auto decision = limiter.acquire(route, req);
+    if (!decision.allowed) {
+      // Rejected before the handler, so no DB, SMTP or hashing work is done
+      res.code = 429;
+      res.set_header("Retry-After", std::to_string(decision.retry_after));
+      res.body = "Too Many Requests";
+      res.end();
+    }
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    // no-op
+  }
+};
+
+} // namespace middleware
+} // namespace rz
@@ -0,0 +1,46 @@
+/**
+ * @file tracing_middleware.hpp
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @brief Tracing Middleware
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+#include "crow.h"
+#include "utils/route_registry.hpp"
+#include "utils/trace.hpp"
+#include <cstdint>
+#include <string>
+
+namespace rz {
+namespace middleware {
+
+struct TracingMiddleware {
+  // Context carries the trace generation and the request ID for the response
+  struct context {
+    std::uint64_t generation = 0;
+    std::string request_id;
+  };
+
+  void before_handle(crow::request &req, crow::response &res, context &ctx) {
+    const auto &route = rz::utils::RouteRegistry::getInstance().match(req.url);
+    ctx.generation = rz::utils::Tracer::beginRequest(
+        req.get_header_value("X-Request-ID"), route.pattern);
+    ctx.request_id = rz::utils::Tracer::requestId();
+  }
+
+  void after_handle(crow::request &req, crow::response &res, context &ctx) {
+    if (!ctx.request_id.empty()) {
+      res.set_header("X-Request-ID", ctx.request_id);
+    }
+    rz::utils::Tracer::endRequest(ctx.generation, res.code);
+  }
+};
+
+} // namespace middleware
+} // namespace rz
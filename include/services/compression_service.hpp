@@ -0,0 +1,112 @@
+/**
+ * SPDX-FileComment: Compression Service Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file compression_service.hpp
+ * @brief Content-Encoding negotiation and a cache of compressed immutable bodies.
+ * @version 0.1.3
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "services/metrics_service.hpp"
+#include "utils/memory_accounting.hpp"
+#include <crow.h>
+#include <cstddef>
+#include <expected>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rz::services {
+
+/**
+ * @brief Compresses response bodies for clients that accept it.
+ *
+ * Responses with an ETag are immutable for that ETag (CachedResponse, static
+ * files), so their compressed bodies are kept in an LRU cache keyed by path,
+ * ETag and coding and are compressed only once. Other bodies are compressed per
+ * request. The compressed variant gets the ETag "<etag>-<coding>", which
+ * HttpCache::ifNoneMatch() accepts for the identity ETag.
+ */
+class CompressionService {
+public:
+    static CompressionService& getInstance();
+
+    /**
+     * @brief Reads COMPRESSION_* keys (levels per content type, size threshold, cache size).
+     */
+    void configure();
+
+    [[nodiscard]] bool enabled() const { return m_enabled; }
+
+    /**
+     * @brief Compresses @p res in place if the request and the response allow it.
+     */
+    void apply(const crow::request& req, crow::response& res);
+
+    /**
+     * @brief Compresses @p data with a content coding ("gzip", "deflate" or "zstd").
+     */
+    static std::expected<std::string, std::string> compress(std::string_view data, std::string_view coding,
+                                                            int level);
+
+    /**
+     * @brief Codings this build supports, in order of preference.
+     */
+    static const std::vector<std::string_view>& codings();
+
+    /**
+     * @brief Evicts least recently used bodies until at most @p target bytes are cached.
+     * @return Bytes released.
+     */
+    std::size_t shrink(std::size_t target);
+
+private:
+    using Body = std::shared_ptr<const std::string>;
+
+    struct Entry {
+        std::string key; // "<path> <ETag> <coding>"
+        Body body;
+    };
+
+    CompressionService();
+    CompressionService(const CompressionService&) = delete;
+    CompressionService& operator=(const CompressionService&) = delete;
+
+    int levelFor(std::string_view content_type) const;
+    Body lookup(const std::string& key);
+    void store(const std::string& key, Body body);
+    void evictLocked(std::size_t target); // Caller holds m_mutex
+
+    bool m_enabled = false;
+    std::size_t m_minBytes = 1024;
+    std::vector<std::pair<std::string, int>> m_levels; // Content-type prefix -> level, longest first
+    std::size_t m_maxCacheBytes = 16 * 1024 * 1024;
+
+    std::mutex m_mutex;
+    std::list<Entry> m_lru; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    std::size_t m_cacheBytes = 0;
+    rz::utils::MemoryAccount& m_memory; // Mirrors m_cacheBytes as the "compression_cache" account
+
+    std::vector<SeriesId> m_codingSeries; // Parallel to codings()
+    SeriesId m_hitSeries = 0;
+    SeriesId m_missSeries = 0;
+};
+
+} // namespace rz::services
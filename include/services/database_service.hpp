@@ -7,8 +7,8 @@
  *
  * @file database_service.hpp
  * @brief Singleton service for SQLite database management.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.6
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -18,12 +18,16 @@
 
 #pragma once
 
-#include <sqlite3.h>
+#include "services/metrics_service.hpp"
+#include <array>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <functional>
 #include <expected>
+#include <memory>
 #include <mutex>
+#include <string_view>
 
 namespace rz::services {
 
@@ -41,15 +45,28 @@ struct NotificationConfig {
     std::string language;
 };
 
+class DbShard;
+
 /**
  * @brief Service to handle SQLite database operations.
+ *
+ * With DB_SHARDS > 1 the users are spread over that many SQLite files by a
+ * hash of their UUID (see shardFor()), so writes to different shards commit
+ * in parallel. Each shard has its own writer and reader connections. With
+ * one shard, DB_DIR is used as is.
+ *
+ * E-mail addresses stay unique across shards: a write first looks the address
+ * up in every shard. Check and write are serialized per address stripe, within
+ * the process by a mutex and across processes (prefork workers) by an fcntl()
+ * lock on "<DB_DIR stem>.email-lock". The lock file only works on a local file
+ * system, like SQLite's own locking.
  */
 class DatabaseService {
 public:
     static DatabaseService& getInstance();
 
     /**
-     * @brief Initializes the database connection and creates tables if missing.
+     * @brief Opens all shards (DB_DIR, DB_SHARDS, DB_READERS) and creates tables if missing.
      * @return std::expected<void, std::string>
      */
     std::expected<void, std::string> init();
@@ -59,6 +76,12 @@ public:
      */
     std::expected<User, std::string> getUser(const std::string& uuid);
 
+    /**
+     * @brief Get several users; the shards involved are queried in parallel.
+     * @return The users found, in the order of @p uuids.
+     */
+    std::expected<std::vector<User>, std::string> getUsers(const std::vector<std::string>& uuids);
+
     /**
      * @brief Get notification configuration for a user.
      */
@@ -66,20 +89,50 @@ public:
 
     /**
      * @brief Create a dummy user and config for testing purposes (Upsert).
+     * @return An error if another user already has the e-mail address.
      */
     std::expected<void, std::string> createOrUpdateUser(const User& user, const NotificationConfig& config);
 
+    /**
+     * @brief Runs a trivial query on every shard (used by the health prober).
+     */
+    std::expected<void, std::string> ping();
+
+    /**
+     * @brief Asks the connections to free unused page cache (the "sqlite" memory account's shrink).
+     * @return Bytes SQLite released.
+     */
+    std::size_t releaseMemory();
+
+    [[nodiscard]] std::size_t shardCount() const { return m_shards.size(); }
+
+    /**
+     * @brief Shard of a UUID: 64-bit FNV-1a of the UUID modulo @p count.
+     *
+     * The hash is part of the on-disk format; changing it requires resharding.
+     */
+    static std::size_t shardFor(std::string_view uuid, std::size_t count);
+
+    /**
+     * @brief File of shard @p index: "<dir>/<stem>.<index>-of-<count><ext>", or @p base for a single shard.
+     */
+    static std::string shardPath(const std::string& base, std::size_t index, std::size_t count);
+
 private:
     DatabaseService() = default;
     ~DatabaseService();
     DatabaseService(const DatabaseService&) = delete;
     DatabaseService& operator=(const DatabaseService&) = delete;
 
-    sqlite3* m_db = nullptr;
+    DbShard* shard(std::string_view uuid);
+
+    std::vector<std::unique_ptr<DbShard>> m_shards;
+    std::vector<SeriesId> m_writeSeries; // Parallel to m_shards
     std::mutex m_mutex;
+    std::array<std::mutex, 16> m_emailLocks; // Striped by e-mail address: check and write as one step
+    int m_emailLockFd = -1;                  // Same stripes across processes (byte i = stripe i); DB_SHARDS > 1 only
     bool m_initialized = false;
-
-    std::expected<void, std::string> executeQuery(const std::string& query);
+    std::once_flag m_memoryProbeOnce; // The "sqlite" probe is registered on the first init() only
 };
 
 } // namespace rz::services
@@ -0,0 +1,134 @@
+/**
+ * SPDX-FileComment: Database Shard Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file db_shard.hpp
+ * @brief One SQLite file with a writer connection and a pool of reader connections.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "services/database_service.hpp"
+#include <sqlite3.h>
+#include <atomic>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rz::services {
+
+/**
+ * @brief A database file holding the users whose UUID hashes to it.
+ *
+ * The file is opened in WAL mode, so readers never wait for the writer. SQLite
+ * allows a single writer per file, so all writes go through one connection
+ * under a mutex, and each read takes one of the reader connections.
+ * Connections are opened with SQLITE_OPEN_NOMUTEX since a connection is only
+ * ever used by the thread holding its mutex.
+ *
+ * Every file records its shard index and the shard count it was created for.
+ * Opening it under a different layout fails instead of routing users to the
+ * wrong file.
+ */
+class DbShard {
+public:
+    struct Options {
+        std::size_t index = 0;
+        std::size_t count = 1;
+        std::size_t readers = 2;       // 0 = reads use the writer connection
+        int busy_timeout_ms = 5000;    // Waits for other processes (prefork workers, the reshard tool)
+        bool read_only = false;        // No schema changes, no writer (source of the reshard tool)
+    };
+
+    /**
+     * @brief Opens (or creates) the file and its connections and verifies the shard layout.
+     */
+    static std::expected<std::unique_ptr<DbShard>, std::string> open(const std::string& path, const Options& options);
+
+    ~DbShard();
+    DbShard(const DbShard&) = delete;
+    DbShard& operator=(const DbShard&) = delete;
+
+    [[nodiscard]] const std::string& path() const { return m_path; }
+
+    std::expected<User, std::string> getUser(const std::string& uuid);
+
+    /**
+     * @brief Like getUser(), but a missing user is not an error.
+     */
+    std::expected<std::optional<User>, std::string> findUser(const std::string& uuid);
+
+    std::expected<std::optional<User>, std::string> findUserByEmail(const std::string& email);
+
+    std::expected<NotificationConfig, std::string> getNotificationConfig(const std::string& user_uuid);
+
+    /**
+     * @brief Creates or updates the users and their configurations in one transaction.
+     *
+     * A user with the same UUID is updated; an e-mail address held by another user fails the transaction.
+     */
+    std::expected<void, std::string> upsert(const std::vector<std::pair<User, NotificationConfig>>& rows);
+
+    /**
+     * @brief Like upsert(), but any existing UUID or e-mail address fails the transaction.
+     */
+    std::expected<void, std::string> insert(const std::vector<std::pair<User, NotificationConfig>>& rows);
+
+    /**
+     * @brief Calls @p fn for every user with its configuration (defaults if it has none).
+     */
+    std::expected<std::size_t, std::string> forEach(
+        const std::function<void(const User&, const NotificationConfig&)>& fn);
+
+    /**
+     * @brief Number of users stored in the file.
+     */
+    std::expected<std::size_t, std::string> count();
+
+    std::expected<void, std::string> ping();
+
+    /**
+     * @brief Frees unused page cache of all connections.
+     * @return Bytes SQLite released.
+     */
+    std::size_t releaseMemory();
+
+private:
+    struct Connection {
+        sqlite3* db = nullptr;
+        std::mutex mutex;
+    };
+
+    DbShard(std::string path, const Options& options);
+
+    std::expected<void, std::string> openConnection(Connection& conn, int flags);
+    std::expected<void, std::string> createSchema();
+    std::unique_lock<std::mutex> lockReader(sqlite3*& db);
+    std::expected<std::optional<User>, std::string> queryUser(const char* sql, const std::string& value);
+    std::expected<void, std::string> write(const std::vector<std::pair<User, NotificationConfig>>& rows,
+                                           const char* user_sql, const char* config_sql);
+
+    std::string m_path;
+    Options m_options;
+    Connection m_writer;
+    std::vector<std::unique_ptr<Connection>> m_readers;
+    std::atomic<std::size_t> m_nextReader{0};
+};
+
+} // namespace rz::services
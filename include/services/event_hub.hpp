@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileComment: Event Hub Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file event_hub.hpp
+ * @brief Server-Sent Events broadcaster backed by a ring of pre-serialized frames.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "utils/memory_accounting.hpp"
+#include <crow.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rz::services {
+
+/**
+ * @brief Broadcasts events to /api/events/stream subscribers.
+ *
+ * Each event is serialized once into an SSE frame and stored in a fixed ring;
+ * subscribers only hold a cursor (the next event ID). The frames a publish
+ * releases are joined once and shared by all windows waiting at the same
+ * cursor; Crow still copies that body into each response. Crow cannot keep a
+ * response body open, so the stream is delivered in windows: a request is
+ * parked until events arrive or EVENT_STREAM_WINDOW_SEC passes, then answered
+ * with all frames after its cursor. EventSource reconnects after `retry:` and
+ * resumes with Last-Event-ID, so no event in the ring is lost. Cursors that
+ * fell out of the ring skip ahead with an "overflow" event; publishers never
+ * wait for subscribers.
+ */
+class EventHub {
+public:
+    static EventHub& getInstance();
+
+    /**
+     * @brief Reads EVENT_RING_SIZE, EVENT_STREAM_WINDOW_SEC, EVENT_STREAM_RETRY_MS
+     * and EVENT_STREAM_MAX_BATCH. Must run before the first publish.
+     */
+    void configure();
+
+    /**
+     * @brief Serializes the event once, stores it in the ring and wakes parked subscribers.
+     * @param type SSE event type ("event:" field).
+     * @param data Payload, sent as a single-line JSON "data:" field.
+     * @return std::uint64_t The event ID.
+     */
+    std::uint64_t publish(std::string_view type, const nlohmann::json& data);
+
+    /**
+     * @brief Handles one stream window; ends @p res now or when events arrive.
+     * @param req The request (Last-Event-ID header or lastEventId query parameter).
+     * @param res The response, completed asynchronously on the request's I/O thread.
+     */
+    void subscribe(const crow::request& req, crow::response& res);
+
+    /**
+     * @brief Number of subscribers currently parked.
+     */
+    [[nodiscard]] std::size_t waiting() const;
+
+private:
+    struct Waiter;
+    using WaiterPtr = std::shared_ptr<Waiter>;
+
+    EventHub();
+    EventHub(const EventHub&) = delete;
+    EventHub& operator=(const EventHub&) = delete;
+
+    using Batch = std::shared_ptr<const std::string>;
+
+    void complete(const WaiterPtr& waiter);
+    Batch collect(std::uint64_t cursor);
+
+    mutable std::mutex m_mutex;
+    std::vector<std::shared_ptr<const std::string>> m_ring; // Frame of event ID i at i % size
+    std::uint64_t m_head = 0;                                // Last published event ID (IDs start at 1)
+    rz::utils::MemoryAccount& m_memory;                      // Frames held by the ring ("event_ring")
+    std::unordered_map<std::uint64_t, WaiterPtr> m_waiters;
+    std::uint64_t m_nextWaiter = 0;
+    Batch m_batch; // Last joined body, for the events m_batchFirst..m_batchLast
+    std::uint64_t m_batchFirst = 0;
+    std::uint64_t m_batchLast = 0;
+
+    std::chrono::seconds m_window{25};
+    int m_retryMs = 250;
+    std::size_t m_maxBatch = 256;
+};
+
+} // namespace rz::services
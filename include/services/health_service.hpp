@@ -0,0 +1,110 @@
+/**
+ * SPDX-FileComment: Health Service Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file health_service.hpp
+ * @brief Background prober publishing an immutable health snapshot.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rz::services {
+
+/**
+ * @brief Result of a single dependency probe.
+ */
+struct HealthCheckResult {
+    std::string name;
+    bool ok;
+    std::chrono::microseconds latency;
+    std::string detail;
+};
+
+/**
+ * @brief Immutable result of one probe round, including the pre-serialized HTTP body.
+ */
+struct HealthSnapshot {
+    std::string status;      // "ok", "degraded", "down" or "starting"
+    int http_code;           // 200 for ok/degraded, 503 otherwise
+    std::string timestamp;   // Local time of the probe round
+    std::vector<HealthCheckResult> checks;
+    std::string body;        // JSON served by /system/health_check
+};
+
+/**
+ * @brief Periodically probes SQLite, the SMTP relay and the template directory.
+ *
+ * Probing happens on a dedicated thread; readers only load an atomically
+ * published snapshot and never block on a dependency.
+ */
+class HealthService {
+public:
+    static HealthService& getInstance();
+
+    /**
+     * @brief Starts the background prober (idempotent).
+     * Interval and timeouts are read from HEALTH_* configuration keys.
+     */
+    void start();
+
+    /**
+     * @brief Stops the background prober and joins its thread.
+     */
+    void stop();
+
+    /**
+     * @brief Blocks until the first probe round has published a snapshot.
+     * @return bool False if @p timeout expired first.
+     */
+    bool waitForFirstProbe(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Returns the latest published snapshot (never null).
+     */
+    [[nodiscard]] std::shared_ptr<const HealthSnapshot> snapshot() const;
+
+private:
+    HealthService();
+    ~HealthService();
+    HealthService(const HealthService&) = delete;
+    HealthService& operator=(const HealthService&) = delete;
+
+    void run(std::stop_token token);
+    void probeOnce();
+
+    HealthCheckResult checkDatabase();
+    HealthCheckResult checkSmtp();
+    HealthCheckResult checkTemplates();
+
+    std::atomic<std::shared_ptr<const HealthSnapshot>> m_snapshot;
+    std::jthread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable_any m_cv;
+    std::condition_variable m_probedCv;
+    bool m_probed = false; // Guarded by m_mutex
+
+    std::chrono::seconds m_interval{5};
+    std::chrono::milliseconds m_smtpTimeout{1000};
+    bool m_checkSmtp = true;
+};
+
+} // namespace rz::services
@@ -0,0 +1,144 @@
+/**
+ * SPDX-FileComment: Metrics Service Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file metrics_service.hpp
+ * @brief Lock-free per-thread latency histograms and counters with Prometheus export.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rz::services {
+
+using SeriesId = std::uint16_t;
+
+/**
+ * @brief Process-wide metrics registry.
+ *
+ * Every thread records into its own shard (single writer, relaxed atomics),
+ * so the hot path neither allocates (after the first sample of a thread)
+ * nor takes a lock. Shards are only summed up when /metrics is scraped.
+ */
+class MetricsService {
+public:
+    static constexpr std::size_t MAX_SERIES = 256;
+
+    /// Upper bounds of the latency buckets in microseconds (+Inf is implicit).
+    static constexpr std::array<std::uint64_t, 17> BUCKET_BOUNDS_US{
+        50, 100, 250, 500, 1'000, 2'500, 5'000, 10'000, 25'000, 50'000,
+        100'000, 250'000, 500'000, 1'000'000, 2'500'000, 5'000'000, 10'000'000};
+    static constexpr std::size_t BUCKET_COUNT = BUCKET_BOUNDS_US.size() + 1;
+
+    static MetricsService& getInstance();
+
+    /**
+     * @brief Registers a latency histogram series (exported in seconds).
+     * @param name Metric family name, e.g. "rz_db_query_duration_seconds".
+     * @param help Help text of the metric family.
+     * @param labels Pre-rendered label set without braces, e.g. "op=\"get_user\"".
+     * @return SeriesId Handle used for recording.
+     */
+    SeriesId registerHistogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /**
+     * @brief Registers a monotonically increasing counter series.
+     */
+    SeriesId registerCounter(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /**
+     * @brief Adds a callback that appends gauge/counter lines (Prometheus text) on scrape.
+     */
+    void addCollector(std::function<void(std::string&)> collector);
+
+    /**
+     * @brief Records a latency sample. Lock-free, allocation-free.
+     */
+    void observe(SeriesId id, std::chrono::nanoseconds latency) noexcept;
+
+    /**
+     * @brief Increments a counter. Lock-free, allocation-free.
+     */
+    void increment(SeriesId id, std::uint64_t value = 1) noexcept;
+
+    /**
+     * @brief Aggregates all thread shards and renders the Prometheus text format.
+     */
+    [[nodiscard]] std::string scrape() const;
+
+    /// One histogram or counter slot inside a thread shard.
+    struct Cell {
+        std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> sum_ns{0};
+    };
+
+    struct alignas(64) Shard {
+        std::array<Cell, MAX_SERIES> cells{};
+    };
+
+private:
+    MetricsService() = default;
+    MetricsService(const MetricsService&) = delete;
+    MetricsService& operator=(const MetricsService&) = delete;
+
+    enum class Kind : std::uint8_t { Histogram, Counter };
+
+    struct Descriptor {
+        std::string name;
+        std::string help;
+        std::string labels;
+        Kind kind;
+    };
+
+    SeriesId registerSeries(const std::string& name, const std::string& help, const std::string& labels, Kind kind);
+    Shard& localShard() noexcept;
+    void releaseShard(Shard* shard);
+
+    friend struct ShardOwner;
+
+    std::array<Descriptor, MAX_SERIES> m_series;
+    std::atomic<std::size_t> m_seriesCount{0};
+
+    mutable std::mutex m_mutex; // guards registration, shard list and collectors
+    std::vector<Shard*> m_shards;
+    std::vector<Shard*> m_freeShards;
+    std::vector<std::function<void(std::string&)>> m_collectors;
+};
+
+/**
+ * @brief RAII helper recording the lifetime of a scope into a histogram.
+ */
+class MetricsTimer {
+public:
+    explicit MetricsTimer(SeriesId id) noexcept : m_id(id), m_start(std::chrono::steady_clock::now()) {}
+    ~MetricsTimer() {
+        MetricsService::getInstance().observe(m_id, std::chrono::steady_clock::now() - m_start);
+    }
+    MetricsTimer(const MetricsTimer&) = delete;
+    MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+private:
+    SeriesId m_id;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace rz::services
@@ -0,0 +1,89 @@
+/**
+ * SPDX-FileComment: Push Service Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file push_service.hpp
+ * @brief Registry of live WebSocket connections per user for push notifications.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <crow.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rz::services {
+
+/**
+ * @brief Routes push messages to all live sockets of a user.
+ *
+ * The registry is split into shards by a hash of the user UUID, each with its
+ * own mutex, so connects, disconnects and sends of different users rarely
+ * contend. Sends only queue the frame on the socket's I/O thread.
+ */
+class PushService {
+public:
+    static PushService& getInstance();
+
+    /**
+     * @brief Reads PUSH_MAX_SOCKETS_PER_USER.
+     */
+    void configure();
+
+    /**
+     * @brief Registers a socket for a user.
+     * @return false if the user already has the maximum number of sockets.
+     */
+    bool add(const std::string& user_uuid, crow::websocket::connection* conn);
+
+    /**
+     * @brief Unregisters a socket (no-op if unknown).
+     */
+    void remove(const std::string& user_uuid, crow::websocket::connection* conn);
+
+    /**
+     * @brief Sends an already serialized text frame to every socket of the user.
+     * @return std::size_t Number of sockets the message was queued on.
+     */
+    std::size_t send(const std::string& user_uuid, const std::string& payload);
+
+    /**
+     * @brief Number of registered sockets over all users.
+     */
+    [[nodiscard]] std::size_t connections() const { return m_connections.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::vector<crow::websocket::connection*>> users;
+    };
+
+    PushService();
+    PushService(const PushService&) = delete;
+    PushService& operator=(const PushService&) = delete;
+
+    Shard& shardFor(std::string_view user_uuid);
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+    std::atomic<std::size_t> m_connections{0};
+    std::size_t m_maxPerUser = 8;
+};
+
+} // namespace rz::services
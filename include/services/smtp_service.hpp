@@ -7,7 +7,7 @@
  *
  * @file smtp_service.hpp
  * @brief Service for sending emails using mailio and inja templates.
- * @version 0.1.0
+ * @version 0.1.2
  * @date 2026-01-31
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <expected>
@@ -47,6 +48,20 @@ public:
         const std::string& lang, 
         const nlohmann::json& data
     );
+
+    /**
+     * @brief Renders the email template of @p lang (falls back to "en") with @p data.
+     *
+     * @return std::expected<std::string, std::string> The HTML body or error message.
+     */
+    static std::expected<std::string, std::string> renderBody(const std::string& lang, const nlohmann::json& data);
+
+    /**
+     * @brief Parses every email_template_*.html of MAIL_TEMPLATE_DIR into the template cache.
+     *
+     * @return std::expected<std::size_t, std::string> Number of templates or error message.
+     */
+    static std::expected<std::size_t, std::string> preloadTemplates();
 };
 
 } // namespace rz::services
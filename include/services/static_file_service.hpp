@@ -0,0 +1,109 @@
+/**
+ * SPDX-FileComment: Static File Service Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file static_file_service.hpp
+ * @brief Serves files below STATIC_DIR with an LRU hot cache, sendfile and conditional GET.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "utils/memory_accounting.hpp"
+#include <crow.h>
+#include <ctime>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace rz::services {
+
+/**
+ * @brief A small file held in memory, validated against the file's size and mtime.
+ */
+struct CachedFile {
+    std::string path;       // Served file (may be the .br/.gz variant)
+    std::string body;
+    std::uintmax_t size;
+    std::time_t mtime;
+};
+
+/**
+ * @brief Static asset handler behind /static/<path>.
+ *
+ * Files up to STATIC_CACHE_FILE_MAX_BYTES are kept in an LRU cache capped at
+ * STATIC_CACHE_MAX_BYTES. Larger files are handed to Crow as static file info,
+ * which the patched Crow connection writes with sendfile(2). Precompressed
+ * ".br" / ".gz" siblings are preferred when the client accepts them.
+ */
+class StaticFileService {
+public:
+    static StaticFileService& getInstance();
+
+    /**
+     * @brief Reads the STATIC_* configuration keys and resolves the root directory.
+     */
+    void configure();
+
+    /**
+     * @brief Fills @p res for the requested path (200, 304, 403 or 404).
+     * @param req The incoming request (conditional and Accept-Encoding headers are evaluated).
+     * @param res The response to fill; the caller ends it.
+     * @param relative Path below the static root as captured by the route.
+     */
+    void serve(const crow::request& req, crow::response& res, std::string_view relative);
+
+    /**
+     * @brief Drops all cached files.
+     */
+    void clear();
+
+    /**
+     * @brief Bytes currently held by the cache.
+     */
+    [[nodiscard]] std::size_t cachedBytes() const;
+
+    /**
+     * @brief Evicts least recently used files until at most @p target bytes are cached.
+     * @return Bytes released.
+     */
+    std::size_t shrink(std::size_t target);
+
+private:
+    StaticFileService();
+    StaticFileService(const StaticFileService&) = delete;
+    StaticFileService& operator=(const StaticFileService&) = delete;
+
+    void evictLocked(std::size_t target); // Caller holds m_mutex
+
+    std::shared_ptr<const CachedFile> lookup(const std::string& path, std::uintmax_t size, std::time_t mtime);
+    std::shared_ptr<const CachedFile> load(const std::string& path, std::uintmax_t size, std::time_t mtime);
+
+    using LruList = std::list<std::shared_ptr<const CachedFile>>;
+
+    mutable std::mutex m_mutex;
+    LruList m_lru; // Most recently used first
+    std::unordered_map<std::string, LruList::iterator> m_index;
+    std::size_t m_bytes = 0;
+    rz::utils::MemoryAccount& m_memory; // Mirrors m_bytes as the "static_cache" account
+
+    std::filesystem::path m_root{"./data/static"};
+    std::size_t m_maxBytes = 32 * 1024 * 1024;
+    std::size_t m_maxFileBytes = 256 * 1024;
+    int m_maxAgeSec = 3600;
+};
+
+} // namespace rz::services
@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileComment: Admission Controller Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file admission_controller.hpp
+ * @brief Adaptive (AIMD) limit on the number of requests in flight.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "services/metrics_service.hpp"
+#include "utils/route_registry.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Global concurrency limiter in front of the handlers.
+ *
+ * Requests are admitted while fewer than limit() are in flight, the rest is
+ * shed immediately. The limit adapts per sample window (AIMD): if the mean
+ * latency of the completed requests exceeded ADMISSION_LATENCY_TARGET_MS it
+ * is cut multiplicatively, otherwise it grows by one as long as the window
+ * actually used it. Admission is two atomic operations; the adjustment is
+ * done by whichever request completes first after the window ended.
+ */
+class AdmissionController {
+public:
+    static AdmissionController& getInstance();
+
+    /**
+     * @brief Reads the ADMISSION_* keys and resolves the exempt routes.
+     *
+     * Must run after all routes are registered. Until then every request is admitted.
+     */
+    std::expected<void, std::string> configure();
+
+    [[nodiscard]] bool enabled() const { return m_enabled; }
+
+    /**
+     * @brief True for routes that bypass the limiter (health, metrics, long polls).
+     */
+    [[nodiscard]] bool exempt(const RouteInfo& route) const noexcept;
+
+    /**
+     * @brief Admits a request if the limit allows it.
+     * @return false if the request must be shed; release() must not be called then.
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief Ends an admitted request and records its latency.
+     */
+    void release(std::chrono::steady_clock::duration latency);
+
+    [[nodiscard]] int limit() const { return m_limit.load(std::memory_order_relaxed); }
+    [[nodiscard]] int inflight() const { return m_inflight.load(std::memory_order_relaxed); }
+    [[nodiscard]] int retryAfter() const { return m_retryAfter; }
+
+private:
+    AdmissionController();
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    void adjust(std::int64_t now_ns);
+
+    std::atomic<int> m_inflight{0};
+    std::atomic<int> m_limit{100};
+    std::atomic<int> m_peak{0};               // Highest in-flight count of the current window
+    std::atomic<std::int64_t> m_sumNs{0};     // Latency sum of the current window
+    std::atomic<std::int64_t> m_samples{0};
+    std::atomic<std::int64_t> m_windowEnd{0}; // steady_clock ns
+    std::mutex m_adjustMutex;
+
+    std::vector<const RouteInfo*> m_exempt; // Read-only after configure()
+    bool m_enabled = false;
+    int m_minLimit = 4;
+    int m_maxLimit = 1000;
+    std::int64_t m_targetNs = 100'000'000;
+    std::int64_t m_windowNs = 200'000'000;
+    int m_retryAfter = 1;
+    rz::services::SeriesId m_shedSeries = 0;
+};
+
+} // namespace rz::utils
@@ -0,0 +1,82 @@
+/**
+ * SPDX-FileComment: Allocator Stats Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file allocator_stats.hpp
+ * @brief Heap statistics of the linked malloc implementation (glibc, mimalloc or jemalloc).
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Reports what the allocator selected by RZ_ALLOCATOR holds.
+ *
+ * The allocator replaces malloc/free process-wide at link time, so the
+ * standard library, Crow, SQLite and all other dependencies use it too.
+ * Fragmentation is the share of the allocator's memory that is not handed out
+ * to the application: 1 - allocated / heap.
+ */
+class AllocatorStats {
+public:
+    struct Arena {
+        std::size_t index = 0;
+        std::size_t heap_bytes = 0;      // Obtained from the OS
+        std::size_t allocated_bytes = 0; // Handed out to the application
+        std::optional<std::size_t> threads;
+    };
+
+    struct Snapshot {
+        std::size_t heap_bytes = 0;
+        std::optional<std::size_t> allocated_bytes; // Unknown for mimalloc, see snapshot()
+        std::size_t resident_bytes = 0;             // RSS of the whole process
+        std::vector<Arena> arenas;                  // Only with arenas = true
+
+        [[nodiscard]] double fragmentation() const;
+    };
+
+    static AllocatorStats& getInstance();
+
+    /**
+     * @brief "system" (glibc), "mimalloc" or "jemalloc".
+     */
+    static std::string_view name();
+
+    /**
+     * @brief Collects the statistics; the per-arena breakdown locks every arena, so it is opt-in.
+     *
+     * mimalloc only yields heap_bytes (committed memory): its thread heaps
+     * cannot be visited from another thread, and its statistics are per thread
+     * until merged, so neither allocated_bytes nor arenas can be filled.
+     */
+    Snapshot snapshot(bool arenas) const;
+
+    /**
+     * @brief {"allocator","resident_bytes","heap_bytes","allocated_bytes","fragmentation","arenas":[...]}
+     */
+    std::string toJson() const;
+
+private:
+    AllocatorStats();
+    AllocatorStats(const AllocatorStats&) = delete;
+    AllocatorStats& operator=(const AllocatorStats&) = delete;
+};
+
+} // namespace rz::utils
@@ -7,7 +7,7 @@
  *
  * @file app_config.hpp
  * @brief Singleton class to manage application configuration loaded from .env file.
- * @version 0.1.0
+ * @version 0.1.1
  * @date 2026-01-31
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
@@ -73,6 +73,16 @@ public:
      */
     [[nodiscard]] int getInt(const std::string& key, int default_value = 0) const;
 
+    /**
+     * @brief Get a boolean configuration value by key.
+     *
+     * Accepts true/false, 1/0, yes/no and on/off, case-insensitive.
+     * @param key Environment variable key.
+     * @param default_value Value to return if key is not found or empty.
+     * @return bool Value or default, or an error naming the key for any other value.
+     */
+    [[nodiscard]] std::expected<bool, std::string> getBool(const std::string& key, bool default_value) const;
+
 private:
     AppConfig() = default;
     ~AppConfig() = default;
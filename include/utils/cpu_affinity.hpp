@@ -0,0 +1,92 @@
+/**
+ * SPDX-FileComment: CPU Affinity Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file cpu_affinity.hpp
+ * @brief CPU set parsing, NUMA topology discovery and thread placement.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <expected>
+#include <set>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
+namespace rz::utils {
+
+using CpuList = std::vector<int>;
+
+/**
+ * @brief Places the Crow I/O threads and the background threads on CPU sets.
+ *
+ * Linux threads inherit the affinity of the thread that creates them. The
+ * main thread therefore switches to the background set before the logger,
+ * flusher and health prober threads are started, and to the I/O set right
+ * before Crow spawns its threads. The new Crow threads are then pinned to
+ * one CPU each, so their thread-local caches stay on the local NUMA node
+ * (first-touch allocation).
+ *
+ * Configuration (CPU_AFFINITY=off|manual|numa):
+ * - manual: CPU_AFFINITY_IO / CPU_AFFINITY_BACKGROUND, e.g. "0-7,16-23"
+ * - numa:   one node per prefork worker (or all nodes), one CPU of the node
+ *           reserved for background threads; CPU_NUMA_NODE forces a node
+ * - CPU_AFFINITY_PIN_IO=true pins each I/O thread to a single CPU.
+ */
+class CpuAffinity {
+public:
+    /**
+     * @brief Parses a Linux cpulist ("0-3,8,10-11").
+     */
+    static std::expected<CpuList, std::string> parseCpuList(std::string_view list);
+
+    /**
+     * @brief CPUs of every NUMA node, restricted to the CPUs allowed for this process.
+     */
+    static std::vector<CpuList> numaNodes();
+
+    /**
+     * @brief Computes the layout from the CPU_AFFINITY* keys.
+     * @param worker_index Prefork worker slot, or -1 in single-process mode.
+     */
+    static std::expected<void, std::string> configure(int worker_index);
+
+    [[nodiscard]] static bool enabled();
+    [[nodiscard]] static const CpuList& ioCpus();
+    [[nodiscard]] static std::string describe();
+
+    /**
+     * @brief Restricts the calling thread (and threads it creates later) to the background set.
+     */
+    static void applyBackground();
+
+    /**
+     * @brief Restricts the calling thread (and threads it creates later) to the I/O set.
+     */
+    static void applyIo();
+
+    /**
+     * @brief Thread IDs of the current process.
+     */
+    static std::set<pid_t> threadIds();
+
+    /**
+     * @brief Pins every thread not in @p before to its own I/O CPU (round-robin).
+     * @return std::size_t Number of pinned threads.
+     */
+    static std::size_t pinNewIoThreads(const std::set<pid_t>& before);
+};
+
+} // namespace rz::utils
@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileComment: HTTP Caching Helpers
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file http_cache.hpp
+ * @brief Pre-serialized immutable responses with strong ETags and conditional GET support.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <crow.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <ctime>
+
+namespace rz::utils {
+
+/**
+ * @brief Helper functions for ETag generation and validation.
+ */
+class HttpCache {
+public:
+    /**
+     * @brief Builds a strong ETag (quoted, truncated SHA-256) for the given content.
+     * @param content The representation bytes.
+     * @return std::string The quoted ETag, e.g. "\"3f2a...\"".
+     */
+    static std::string makeEtag(std::string_view content);
+
+    /**
+     * @brief Evaluates an If-None-Match header against an ETag (weak comparison, RFC 9110).
+     *
+     * The ETags of compressed variants ("<etag>-gzip", ...) match their identity ETag.
+     * @param header Value of the If-None-Match request header.
+     * @param etag The current quoted ETag of the resource.
+     * @return true if the client copy is still valid (respond with 304).
+     */
+    static bool ifNoneMatch(std::string_view header, std::string_view etag);
+
+    /**
+     * @brief Formats a timestamp as an IMF-fixdate (RFC 9110), e.g. "Sun, 18 Oct 2026 08:00:00 GMT".
+     * @param t Seconds since the epoch.
+     * @return std::string The formatted date.
+     */
+    static std::string httpDate(std::time_t t);
+
+    /**
+     * @brief Evaluates an If-Modified-Since header against the resource's modification time.
+     * @param header Value of the If-Modified-Since request header.
+     * @param last_modified Modification time of the resource (seconds since the epoch).
+     * @return true if the resource is unchanged since the given date (respond with 304).
+     */
+    static bool notModifiedSince(std::string_view header, std::time_t last_modified);
+
+    /**
+     * @brief Checks whether an Accept-Encoding header allows a content coding (q=0 excludes it).
+     * @param header Value of the Accept-Encoding request header.
+     * @param coding The content coding, e.g. "gzip".
+     * @return true if the client accepts the coding.
+     */
+    static bool acceptsEncoding(std::string_view header, std::string_view coding);
+};
+
+/**
+ * @brief An immutable response body serialized once and shared by all requests.
+ *
+ * Intended for endpoints whose payload only depends on build-time constants.
+ */
+class CachedResponse {
+public:
+    /**
+     * @brief Creates the cached response and computes its ETag.
+     * @param body The serialized body.
+     * @param content_type Value of the Content-Type header.
+     */
+    CachedResponse(std::string body, std::string content_type);
+
+    /**
+     * @brief Serves the cached body, or 304 Not Modified if the client's ETag matches.
+     * @param req The incoming request (If-None-Match is evaluated).
+     * @return crow::response Ready-to-send response.
+     */
+    [[nodiscard]] crow::response serve(const crow::request& req) const;
+
+    [[nodiscard]] const std::string& body() const { return m_body; }
+    [[nodiscard]] const std::string& etag() const { return m_etag; }
+    [[nodiscard]] const std::string& contentType() const { return m_contentType; }
+
+private:
+    const std::string m_body;
+    const std::string m_contentType;
+    const std::string m_etag;
+};
+
+using CachedResponsePtr = std::shared_ptr<const CachedResponse>;
+
+} // namespace rz::utils
@@ -0,0 +1,92 @@
+/**
+ * SPDX-FileComment: JSON Reader Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file json_reader.hpp
+ * @brief Read-only JSON parser whose values are views into the request body.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "utils/request_arena.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace rz::utils {
+
+struct JsonMember;
+
+/**
+ * @brief A parsed JSON value.
+ *
+ * Strings and numbers are string_views into the parsed text; only strings
+ * containing escapes are decoded into the arena. Objects and arrays are
+ * contiguous arrays of members in the arena (array members have empty keys).
+ * A value is valid as long as both the text and the arena are.
+ */
+struct JsonValue {
+    enum class Type : std::uint8_t { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    std::string_view text;              // String contents or number literal
+    const JsonMember* members = nullptr; // Array / Object
+    std::size_t count = 0;
+
+    [[nodiscard]] bool isNull() const { return type == Type::Null; }
+    [[nodiscard]] bool isObject() const { return type == Type::Object; }
+    [[nodiscard]] bool isArray() const { return type == Type::Array; }
+
+    [[nodiscard]] std::optional<std::string_view> asString() const;
+    [[nodiscard]] std::optional<std::int64_t> asInt() const;
+    [[nodiscard]] std::optional<double> asDouble() const;
+    [[nodiscard]] std::optional<bool> asBool() const;
+
+    /**
+     * @brief Looks up an object member (linear; request objects are small).
+     * @return const JsonValue* The value, or nullptr if absent or not an object.
+     */
+    [[nodiscard]] const JsonValue* find(std::string_view key) const;
+
+    /**
+     * @brief Element @p index of an array, or nullptr.
+     */
+    [[nodiscard]] const JsonValue* at(std::size_t index) const;
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] const JsonMember* begin() const { return members; }
+    [[nodiscard]] const JsonMember* end() const;
+};
+
+struct JsonMember {
+    std::string_view key;
+    JsonValue value;
+};
+
+inline const JsonMember* JsonValue::end() const { return members + count; }
+
+/**
+ * @brief Parses @p text (RFC 8259) into @p arena.
+ * @param text The JSON document, e.g. req.body; must outlive the result.
+ * @param arena Memory for containers and decoded strings; defaults to the request arena.
+ * @return The root value, or an error message with the byte offset.
+ */
+std::expected<const JsonValue*, std::string> parseJson(std::string_view text,
+                                                       std::pmr::memory_resource* arena = RequestArena::resource());
+
+} // namespace rz::utils
@@ -0,0 +1,189 @@
+/**
+ * SPDX-FileComment: JSON Writer Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file json_writer.hpp
+ * @brief Streaming JSON serializer that appends straight into a string buffer.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <crow.h>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace rz::utils {
+
+/**
+ * @brief A field name serialized at compile time, including quotes and colon.
+ *
+ * Names that would need escaping are rejected at compile time.
+ */
+template <std::size_t N>
+struct JsonKey {
+    char text[N + 2]{}; // '"' + name (N - 1) + '"' + ':'
+
+    consteval JsonKey(const char (&name)[N]) {
+        text[0] = '"';
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+            const auto c = static_cast<unsigned char>(name[i]);
+            if (c < 0x20 || c == '"' || c == '\\') {
+                throw "JsonKey: field names must not need escaping";
+            }
+            text[i + 1] = name[i];
+        }
+        text[N] = '"';
+        text[N + 1] = ':';
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const { return {text, N + 2}; }
+};
+
+/**
+ * @brief Writes JSON text without building a DOM.
+ *
+ * Values are appended in document order; separators are inserted
+ * automatically. Field names given as template arguments cost a single
+ * append, strings are copied in runs between the characters that need
+ * escaping (found eight bytes at a time). The writer either owns its buffer
+ * (reserved up front and moved out with take() / response()) or appends to
+ * a caller's string. Strings are expected to be valid UTF-8 and are not
+ * validated.
+ *
+ * @code
+ * JsonWriter json;
+ * json.beginObject().field<"status">("ok").field<"latency_us">(42).endObject();
+ * return json.response();
+ * @endcode
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief Writes into an owned buffer.
+     * @param reserve Initial capacity; size it for the typical document.
+     */
+    explicit JsonWriter(std::size_t reserve = 256) : m_out(&m_buffer) { m_buffer.reserve(reserve); }
+
+    /**
+     * @brief Appends to @p out, which must outlive the writer.
+     */
+    explicit JsonWriter(std::string& out) : m_out(&out) {}
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& beginObject() {
+        separate();
+        m_out->push_back('{');
+        m_needComma = false;
+        return *this;
+    }
+
+    JsonWriter& endObject() {
+        m_out->push_back('}');
+        m_needComma = true;
+        return *this;
+    }
+
+    JsonWriter& beginArray() {
+        separate();
+        m_out->push_back('[');
+        m_needComma = false;
+        return *this;
+    }
+
+    JsonWriter& endArray() {
+        m_out->push_back(']');
+        m_needComma = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a compile-time field name; the next call writes its value.
+     */
+    template <JsonKey Name>
+    JsonWriter& key() {
+        separate();
+        m_out->append(Name.view());
+        m_needComma = false;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a field name known only at run time (escaped).
+     */
+    JsonWriter& key(std::string_view name);
+
+    template <JsonKey Name, typename T>
+    JsonWriter& field(const T& value) {
+        key<Name>();
+        return this->value(value);
+    }
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(const std::string& text) { return value(std::string_view(text)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& value(std::nullptr_t);
+    JsonWriter& value(std::int64_t number);
+    JsonWriter& value(std::uint64_t number);
+    JsonWriter& value(double number); // NaN and infinity are written as null
+
+    template <std::integral T>
+        requires(!std::same_as<T, bool> && !std::same_as<T, std::int64_t> && !std::same_as<T, std::uint64_t>)
+    JsonWriter& value(T number) {
+        if constexpr (std::is_signed_v<T>) {
+            return value(static_cast<std::int64_t>(number));
+        } else {
+            return value(static_cast<std::uint64_t>(number));
+        }
+    }
+
+    JsonWriter& value(float number) { return value(static_cast<double>(number)); }
+
+    /**
+     * @brief Appends an already serialized JSON value verbatim.
+     */
+    JsonWriter& raw(std::string_view json);
+
+    /**
+     * @brief Appends @p text as a JSON string (quoted and escaped) to @p out.
+     */
+    static void appendEscaped(std::string& out, std::string_view text);
+
+    [[nodiscard]] const std::string& str() const { return *m_out; }
+
+    /**
+     * @brief Moves the document out; the writer is empty afterwards.
+     */
+    std::string take();
+
+    /**
+     * @brief Moves the document into a response with Content-Type application/json.
+     */
+    crow::response response(int code = 200);
+
+private:
+    void separate() {
+        if (m_needComma) m_out->push_back(',');
+    }
+
+    std::string m_buffer;
+    std::string* m_out;
+    bool m_needComma = false;
+};
+
+} // namespace rz::utils
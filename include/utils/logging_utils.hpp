@@ -0,0 +1,68 @@
+/**
+ * SPDX-FileComment: Logging Setup
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file logging_utils.hpp
+ * @brief Creates the default spdlog logger (synchronous or asynchronous).
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+
+namespace rz::utils {
+
+/**
+ * @brief Logger settings, read from the LOG_* configuration keys.
+ */
+struct LoggingOptions {
+    std::string file;                   // Rotating log file path
+    std::string level = "info";         // LOG_LEVEL
+    bool async = false;                 // LOG_ASYNC
+    std::size_t queue_size = 8192;      // LOG_ASYNC_QUEUE_SIZE (preallocated slots)
+    bool drop_oldest = false;           // LOG_ASYNC_OVERFLOW=drop_oldest (default: block)
+    int flush_interval_sec = 3;         // LOG_FLUSH_INTERVAL_SEC
+};
+
+class LoggingUtils {
+public:
+    /**
+     * @brief Reads the LOG_* keys from AppConfig.
+     * @param log_file Path of the rotating log file.
+     */
+    static LoggingOptions optionsFromConfig(const std::string& log_file);
+
+    /**
+     * @brief Creates the console + rotating file logger and installs it as default.
+     *
+     * In async mode, messages are handed to a preallocated ring buffer and
+     * written by a dedicated spdlog worker thread, so request threads never
+     * touch the sink mutexes or do file I/O.
+     */
+    static std::expected<void, std::string> init(const LoggingOptions& options);
+
+    /**
+     * @brief Number of messages dropped because the async queue was full.
+     */
+    static std::uint64_t droppedMessages();
+
+    /**
+     * @brief Flushes and stops all loggers (and the async worker).
+     */
+    static void shutdown();
+};
+
+} // namespace rz::utils
@@ -0,0 +1,158 @@
+/**
+ * SPDX-FileComment: Memory Accounting Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file memory_accounting.hpp
+ * @brief Registry of per-subsystem memory usage with soft limits that shrink caches.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "services/metrics_service.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Lock-free usage counter of one subsystem; the peak follows every update.
+ */
+class MemoryAccount {
+public:
+    void add(std::size_t bytes) { raisePeak(m_current.fetch_add(bytes, std::memory_order_relaxed) + bytes); }
+    void sub(std::size_t bytes) { m_current.fetch_sub(bytes, std::memory_order_relaxed); }
+    void set(std::size_t bytes) {
+        m_current.store(bytes, std::memory_order_relaxed);
+        raisePeak(bytes);
+    }
+
+    [[nodiscard]] std::size_t current() const { return m_current.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t peak() const { return m_peak.load(std::memory_order_relaxed); }
+
+private:
+    void raisePeak(std::size_t bytes) {
+        std::size_t peak = m_peak.load(std::memory_order_relaxed);
+        while (bytes > peak && !m_peak.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic<std::size_t> m_current{0};
+    std::atomic<std::size_t> m_peak{0};
+};
+
+/**
+ * @brief Where the memory of the process goes, by subsystem.
+ *
+ * Subsystems either keep a MemoryAccount up to date (caches, queues, scratch
+ * buffers) or register a probe that is read on demand (SQLite reports through
+ * sqlite3_status64). Shrinkable subsystems pass a callback that releases memory
+ * down to a target size and returns the bytes released.
+ *
+ * Soft limits are enforced by a background check every MEMORY_CHECK_INTERVAL_SEC:
+ * - MEMORY_LIMITS ("static_cache=16777216;sqlite=8388608") caps single accounts.
+ * - MEMORY_SOFT_LIMIT_BYTES caps the sum of all accounts; the excess is taken
+ *   from the shrinkable accounts, largest first.
+ * Limits are soft: usage may exceed them until the next check, and accounts
+ * without a shrink callback are only reported.
+ */
+class MemoryAccounting {
+public:
+    struct Usage {
+        std::size_t current = 0;
+        std::size_t peak = 0;
+    };
+
+    using Probe = std::function<Usage()>;
+    using Shrink = std::function<std::size_t(std::size_t target)>;
+
+    static MemoryAccounting& getInstance();
+
+    /**
+     * @brief The counter of @p name, created on first use; the reference stays valid.
+     */
+    MemoryAccount& account(std::string_view name, Shrink shrink = {});
+
+    /**
+     * @brief Registers a subsystem that reports its own usage.
+     */
+    void addProbe(std::string_view name, Probe probe, Shrink shrink = {});
+
+    /**
+     * @brief Reads MEMORY_LIMITS, MEMORY_SOFT_LIMIT_BYTES and MEMORY_CHECK_INTERVAL_SEC
+     * and starts the check when a limit is set.
+     */
+    void configure();
+
+    void stop();
+
+    /**
+     * @brief The soft limit of @p name, or 0 if it has none.
+     */
+    [[nodiscard]] std::size_t limit(std::string_view name) const;
+
+    /**
+     * @brief Shrinks the accounts over their limits and then the largest ones over the total limit.
+     * @return Bytes released.
+     */
+    std::size_t enforce();
+
+    /**
+     * @brief {"accounts":[{"name","current_bytes","peak_bytes",..}],"total_bytes","soft_limit_bytes",
+     * "resident_bytes","unaccounted_bytes"}
+     */
+    [[nodiscard]] std::string toJson() const;
+
+private:
+    struct Entry {
+        std::string name;
+        Probe probe;
+        Shrink shrink;
+        rz::services::SeriesId shrinkSeries = 0;
+    };
+
+    MemoryAccounting();
+    ~MemoryAccounting();
+    MemoryAccounting(const MemoryAccounting&) = delete;
+    MemoryAccounting& operator=(const MemoryAccounting&) = delete;
+
+    Entry& addEntry(std::string_view name, Probe probe, Shrink shrink);
+    std::vector<const Entry*> entries() const;
+    std::size_t shrink(const Entry& entry, std::size_t current, std::size_t target, std::string_view reason);
+    void run(std::stop_token token);
+
+    mutable std::shared_mutex m_mutex;
+    std::deque<Entry> m_entries;         // Stable addresses, registration order
+    std::deque<MemoryAccount> m_accounts; // Backing counters of account()
+    std::unordered_map<std::string, MemoryAccount*> m_accountIndex;
+    std::unordered_map<std::string, std::size_t> m_limits; // From MEMORY_LIMITS
+    std::size_t m_softLimit = 0;
+
+    std::mutex m_enforceMutex; // One enforcement pass at a time
+    std::chrono::seconds m_interval{5};
+    std::jthread m_thread;
+    std::mutex m_waitMutex;
+    std::condition_variable_any m_cv;
+};
+
+} // namespace rz::utils
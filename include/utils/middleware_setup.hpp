@@ -0,0 +1,44 @@
+/**
+ * SPDX-FileComment: Middleware Setup Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file middleware_setup.hpp
+ * @brief Configures the state behind the global middleware chain of rz::App.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+namespace rz::utils {
+
+/**
+ * @brief One place for the middleware configuration, shared by the server,
+ * bench_http and pgo_train so that all of them run the same chain.
+ *
+ * Usage: configure() before the routes are registered and the I/O threads
+ * start, configurePolicies() once all routes are declared.
+ */
+class MiddlewareSetup {
+public:
+    /**
+     * @brief Request arena and compression settings.
+     */
+    static void configure();
+
+    /**
+     * @brief Rate limit and admission control policies; they refer to route
+     * patterns. Configuration errors are logged, the affected policies stay off.
+     */
+    static void configurePolicies();
+};
+
+} // namespace rz::utils
@@ -0,0 +1,80 @@
+/**
+ * SPDX-FileComment: Prefork Supervisor Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file prefork_supervisor.hpp
+ * @brief Forks N worker processes sharing the listen port via SO_REUSEPORT.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <sys/types.h>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Multi-process supervisor.
+ *
+ * Each worker runs the full server (own DB connections, caches, threads)
+ * and binds the port with SO_REUSEPORT, so the kernel balances connections.
+ * Crashed workers are restarted (with backoff on crash loops); SIGHUP rolls
+ * all workers over one at a time; SIGTERM/SIGINT stops everything.
+ *
+ * Must be called before any thread is started in the process.
+ */
+class PreforkSupervisor {
+public:
+    /**
+     * @brief Entry point of a worker.
+     * @param worker_index Slot index of the worker (0..N-1).
+     * @param ready_fd Pipe to write one byte to once the server accepts connections.
+     * @return int Process exit code.
+     */
+    using WorkerFn = std::function<int(unsigned worker_index, int ready_fd)>;
+
+    explicit PreforkSupervisor(unsigned workers);
+
+    /**
+     * @brief Runs the supervisor loop until SIGTERM/SIGINT.
+     * @return int Exit code of the supervisor (never returns in workers).
+     */
+    int run(const WorkerFn& worker);
+
+    /**
+     * @brief Signals readiness to the supervisor (no-op if fd < 0).
+     */
+    static void notifyReady(int ready_fd);
+
+private:
+    struct Slot {
+        pid_t pid = -1;
+        int ready_fd = -1;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point restart_at;
+        unsigned fast_failures = 0;
+    };
+
+    pid_t spawn(unsigned index, const WorkerFn& worker);
+    bool waitReady(Slot& slot, std::chrono::seconds timeout);
+    void reap();
+    void rollingRestart(const WorkerFn& worker);
+    void stopAll();
+
+    unsigned m_workers;
+    std::vector<Slot> m_slots;
+};
+
+} // namespace rz::utils
@@ -0,0 +1,120 @@
+/**
+ * SPDX-FileComment: Rate Limiter Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file rate_limiter.hpp
+ * @brief Per-route token buckets keyed by client IP and bearer token.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "services/metrics_service.hpp"
+#include "utils/route_registry.hpp"
+#include <crow.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Outcome of RateLimiter::acquire().
+ */
+struct RateDecision {
+    bool allowed = true;
+    int retry_after = 0; // Seconds until a token is available (when rejected)
+};
+
+/**
+ * @brief Token-bucket rate limiting for the declared routes.
+ *
+ * Policies are configured per route pattern (RATE_LIMIT_ROUTES) with an
+ * optional default for all other routes (RATE_LIMIT_DEFAULT). Each request
+ * takes one token from the bucket of its client IP and, if it carries a bearer
+ * token, from the bucket of that token. Buckets live in 64 mutex-striped
+ * shards indexed by a 64-bit hash of (policy, client); idle buckets are full
+ * again and are dropped by a periodic sweep of each shard.
+ */
+class RateLimiter {
+public:
+    static RateLimiter& getInstance();
+
+    /**
+     * @brief Reads the RATE_LIMIT_* keys and resolves the route policies.
+     *
+     * Must run after all routes are registered; routes that were not declared
+     * are reported and skipped. Until then every request is allowed.
+     */
+    std::expected<void, std::string> configure();
+
+    /**
+     * @brief Takes one token for the request from the policy of @p route.
+     */
+    RateDecision acquire(const RouteInfo& route, const crow::request& req);
+
+    [[nodiscard]] bool enabled() const { return m_enabled; }
+
+    /**
+     * @brief Number of live buckets over all shards.
+     */
+    [[nodiscard]] std::size_t buckets() const { return m_buckets.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 64;
+
+    struct Policy {
+        const RouteInfo* route = nullptr; // nullptr: default policy
+        double rate = 0;                  // Tokens per second
+        double burst = 0;                 // Bucket capacity
+        rz::services::SeriesId rejected_series = 0;
+    };
+
+    struct Bucket {
+        double tokens;
+        std::int64_t last_ns; // steady_clock time of the last refill
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, Bucket> buckets;
+        std::int64_t next_sweep_ns = 0;
+    };
+
+    RateLimiter();
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    const Policy* policyFor(const RouteInfo& route) const noexcept;
+    RateDecision take(const Policy& policy, std::uint64_t key, std::int64_t now_ns);
+    void sweep(Shard& shard, std::int64_t now_ns);
+    std::string clientAddress(const crow::request& req) const;
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+    std::atomic<std::size_t> m_buckets{0};
+
+    std::vector<Policy> m_policies; // Read-only after configure()
+    Policy m_default;
+    bool m_hasDefault = false;
+    bool m_enabled = false;
+    bool m_trustProxy = false;
+    std::int64_t m_idleNs = 300'000'000'000;
+    std::size_t m_maxPerShard = 100'000 / SHARD_COUNT;
+};
+
+} // namespace rz::utils
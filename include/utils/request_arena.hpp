@@ -0,0 +1,67 @@
+/**
+ * SPDX-FileComment: Request Arena Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file request_arena.hpp
+ * @brief Per-thread monotonic std::pmr arena, released after every response.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace rz::utils {
+
+/**
+ * @brief Scratch memory for the request currently handled on this thread.
+ *
+ * Each I/O thread owns a std::pmr::monotonic_buffer_resource over a buffer of
+ * REQUEST_ARENA_BYTES. Allocations are pointer bumps without locking; when the
+ * buffer is exhausted further blocks come from the heap. ArenaMiddleware
+ * releases everything after each response, so memory from resource() must
+ * not outlive the handler call (asynchronous handlers must copy what they keep).
+ *
+ * In debug builds the arena counts allocations per request (stats()).
+ */
+class RequestArena {
+public:
+    struct Stats {
+        std::uint64_t allocations = 0;     // Allocations served by the arena
+        std::uint64_t bytes = 0;           // Bytes requested from the arena
+        std::uint64_t upstream_blocks = 0; // Blocks the arena had to take from the heap
+    };
+
+    /**
+     * @brief Reads REQUEST_ARENA_BYTES; threads created afterwards use the new size.
+     */
+    static void configure();
+
+    /**
+     * @brief This thread's arena.
+     */
+    static std::pmr::memory_resource* resource();
+
+    /**
+     * @brief Releases all allocations of this thread's arena (keeps the initial buffer).
+     */
+    static void reset();
+
+    /**
+     * @brief Allocation counts since the last reset(); all zero in release builds.
+     */
+    static Stats stats();
+};
+
+} // namespace rz::utils
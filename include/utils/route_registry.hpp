@@ -0,0 +1,133 @@
+/**
+ * SPDX-FileComment: Route Registry Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file route_registry.hpp
+ * @brief Registry of declared routes, used by middlewares to resolve per-route state.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include "services/metrics_service.hpp"
+#include <array>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <string_view>
+
+namespace rz::utils {
+
+/**
+ * @brief Concurrency budget of a route; requests over it fail fast.
+ */
+struct Bulkhead {
+    int capacity = 0;
+    std::atomic<int> inflight{0};
+    rz::services::SeriesId rejected_series = 0;
+
+    /**
+     * @brief Takes a slot; false if the route is at capacity.
+     */
+    bool tryEnter() noexcept {
+        if (inflight.fetch_add(1, std::memory_order_relaxed) < capacity) return true;
+        inflight.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void leave() noexcept { inflight.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Per-route state shared by the middlewares.
+ */
+struct RouteInfo {
+    std::string pattern;   // Crow route pattern, e.g. "/static/<path>"
+    std::string prefix;    // Literal part before the first parameter
+    bool has_params = false;
+    Bulkhead* bulkhead = nullptr; // Set if the route was declared with a budget
+
+    rz::services::SeriesId latency_series = 0;
+    std::array<rz::services::SeriesId, 5> response_series{}; // 1xx .. 5xx
+};
+
+/**
+ * @brief Keeps the routes declared by the controllers.
+ *
+ * Routes are declared while the controllers register them (single-threaded
+ * startup). Afterwards the registry is read-only and match() is lock-free.
+ */
+class RouteRegistry {
+public:
+    static RouteRegistry& getInstance();
+
+    /**
+     * @brief Declares a route pattern (idempotent).
+     * @param pattern The Crow route pattern.
+     * @return const RouteInfo& Stable reference to the route's state.
+     */
+    const RouteInfo& declare(std::string_view pattern);
+
+    /**
+     * @brief Declares a route with a concurrency budget (bulkhead).
+     * @param pattern The Crow route pattern.
+     * @param max_concurrent Requests the route may run at once; <= 0 means unlimited.
+     * @return const RouteInfo& Stable reference to the route's state.
+     */
+    const RouteInfo& declare(std::string_view pattern, int max_concurrent);
+
+    /**
+     * @brief Resolves a request path to its declared route.
+     * @param url The request path (without query string).
+     * @return const RouteInfo& The matching route, or the shared "unmatched" entry.
+     */
+    [[nodiscard]] const RouteInfo& match(std::string_view url) const noexcept;
+
+    /**
+     * @brief Looks up a declared route by its pattern.
+     * @param pattern The Crow route pattern.
+     * @return const RouteInfo* The route, or nullptr if it was not declared.
+     */
+    [[nodiscard]] const RouteInfo* find(std::string_view pattern) const noexcept;
+
+private:
+    RouteRegistry();
+    RouteRegistry(const RouteRegistry&) = delete;
+    RouteRegistry& operator=(const RouteRegistry&) = delete;
+
+    RouteInfo& entry(std::string_view pattern);
+    void initSeries(RouteInfo& info, std::string_view label);
+
+    std::deque<RouteInfo> m_routes; // deque keeps references stable
+    std::deque<Bulkhead> m_bulkheads;
+    RouteInfo m_unmatched;
+};
+
+} // namespace rz::utils
+
+/**
+ * @brief Declares a route in the RouteRegistry and registers it with Crow.
+ *
+ * Usage is identical to CROW_ROUTE: RZ_ROUTE(app, "/status")([]{ ... });
+ */
+#define RZ_ROUTE(app, url) \
+    (static_cast<void>(::rz::utils::RouteRegistry::getInstance().declare(url)), CROW_ROUTE(app, url))
+
+/**
+ * @brief Like RZ_ROUTE, but limits the route to @p max_concurrent requests in flight.
+ *
+ * Further requests are answered with 503 by the BulkheadMiddleware before the
+ * handler runs: RZ_ROUTE_BULKHEAD(app, "/system/test_email", 2)([]{ ... });
+ */
+#define RZ_ROUTE_BULKHEAD(app, url, max_concurrent)                                                   \
+    (static_cast<void>(::rz::utils::RouteRegistry::getInstance().declare(url, max_concurrent)), \
+     CROW_ROUTE(app, url))
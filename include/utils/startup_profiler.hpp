@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileComment: Startup Profiler Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file startup_profiler.hpp
+ * @brief Records the duration of every startup phase and the time to readiness.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Timeline of the startup phases, reported once the server is ready.
+ *
+ * Phases may run concurrently on different threads; each records its offset
+ * from begin() and its duration. Phases that overlap show up with overlapping
+ * offsets, so the report also tells how much the parallel initialization saves.
+ */
+class StartupProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Record {
+        std::string name;
+        double start_ms;
+        double duration_ms;
+    };
+
+    /**
+     * @brief Scope of one phase; the duration is recorded by end() or on destruction.
+     */
+    class Phase {
+    public:
+        Phase(StartupProfiler& profiler, std::string name);
+        ~Phase() { end(); }
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+        void end();
+
+    private:
+        StartupProfiler& m_profiler;
+        std::string m_name;
+        Clock::time_point m_start;
+        bool m_ended = false;
+    };
+
+    static StartupProfiler& getInstance();
+
+    /**
+     * @brief Starts a new timeline (process start, or a forked prefork worker).
+     */
+    void begin();
+
+    [[nodiscard]] Phase phase(std::string name) { return Phase(*this, std::move(name)); }
+
+    /**
+     * @brief Marks the process ready and logs the timeline at info level.
+     */
+    void markReady();
+
+    [[nodiscard]] bool ready() const { return m_ready.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Milliseconds from begin() to markReady(), or 0 while not ready.
+     */
+    [[nodiscard]] double timeToReadyMs() const;
+
+    [[nodiscard]] std::vector<Record> records() const;
+
+    /**
+     * @brief {"complete":..,"time_to_ready_ms":..,"phases":[{"name","start_ms","duration_ms"}]}
+     */
+    [[nodiscard]] std::string toJson() const;
+
+private:
+    StartupProfiler();
+    StartupProfiler(const StartupProfiler&) = delete;
+    StartupProfiler& operator=(const StartupProfiler&) = delete;
+
+    void record(std::string name, Clock::time_point start, Clock::time_point end);
+
+    mutable std::mutex m_mutex;
+    Clock::time_point m_begin;
+    std::vector<Record> m_records;
+    double m_timeToReadyMs = 0;
+    std::atomic<bool> m_ready{false};
+};
+
+} // namespace rz::utils
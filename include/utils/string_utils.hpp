@@ -0,0 +1,53 @@
+/**
+ * SPDX-FileComment: String Utilities Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file string_utils.hpp
+ * @brief Trimming and the "key=value;key=value" list format of the configuration.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rz::utils {
+
+/**
+ * @brief Small parsing helpers shared by header and configuration parsers.
+ *
+ * All results are views into the argument, which must outlive them.
+ */
+class StringUtils {
+public:
+    /**
+     * @brief Strips spaces and tabs from both ends.
+     */
+    static std::string_view trim(std::string_view text);
+
+    /**
+     * @brief Splits a ';'-separated list (RATE_LIMIT_ROUTES, ADMISSION_EXEMPT, ...).
+     * @return The trimmed entries, empty ones skipped.
+     */
+    static std::vector<std::string_view> splitList(std::string_view list);
+
+    /**
+     * @brief Splits an entry at its last '=' (keys such as route patterns may contain one).
+     * @return Trimmed key and value, or std::nullopt without '=' or with an empty key.
+     */
+    static std::optional<std::pair<std::string_view, std::string_view>> splitKeyValue(std::string_view entry);
+};
+
+} // namespace rz::utils
@@ -0,0 +1,106 @@
+/**
+ * SPDX-FileComment: TLS Context Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file tls_context.hpp
+ * @brief Server TLS context with session cache, rotating ticket keys and handshake metrics.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#ifdef CROW_ENABLE_SSL
+
+#include "services/metrics_service.hpp"
+#include <crow.h>
+#include <openssl/ssl.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <shared_mutex>
+#include <string>
+
+namespace rz::utils {
+
+/**
+ * @brief Builds the ssl::context handed to Crow's App::ssl().
+ *
+ * Resumption is what keeps reconnecting clients cheap: a resumed handshake
+ * skips the certificate and the key exchange signature. Both mechanisms are
+ * enabled:
+ * - The session cache of the SSL_CTX, shared by all I/O threads (TLS 1.2
+ *   session IDs).
+ * - Session tickets (TLS 1.2 and 1.3 PSK). Tickets are encrypted with our own
+ *   keys, which rotate every TLS_TICKET_ROTATE_SEC. The last TLS_TICKET_KEYS
+ *   keys still decrypt, and tickets under an older key are renewed. With
+ *   TLS_TICKET_SECRET, the keys are derived from the secret and the rotation
+ *   epoch, so prefork workers and other hosts share them without coordination.
+ *
+ * An optional ECDSA certificate (TLS_ECDSA_CERT_FILE / TLS_ECDSA_KEY_FILE) is
+ * loaded next to the RSA one; OpenSSL serves it to clients that support it.
+ */
+class TlsContext {
+public:
+    static TlsContext& getInstance();
+
+    /**
+     * @brief Creates the context from the TLS_* keys.
+     * @return The context, or an error if a certificate or key cannot be loaded.
+     */
+    std::expected<crow::ssl_context_t, std::string> create();
+
+private:
+    struct TicketKey {
+        std::int64_t epoch = 0;
+        std::array<unsigned char, 16> name{};
+        std::array<unsigned char, 32> aes{};
+        std::array<unsigned char, 32> hmac{};
+    };
+
+    TlsContext();
+    TlsContext(const TlsContext&) = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
+    std::int64_t currentEpoch() const;
+    bool makeKey(std::int64_t epoch, TicketKey& key) const;
+    void rotate(std::int64_t epoch);
+
+    static void infoCallback(const SSL* ssl, int where, int ret);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    static int ticketCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cipher,
+                              EVP_MAC_CTX* mac, int encrypt);
+#endif
+
+    SSL_CTX* m_ctx = nullptr; // Extra reference for the metrics collector; Crow owns the context
+    int m_countedIndex = -1;  // SSL ex_data slot: handshake already counted
+
+    std::string m_ticketSecret; // Empty = random keys per process
+    int m_rotateSec = 3600;
+    std::size_t m_keepKeys = 3;
+    std::shared_mutex m_keysMutex;
+    std::deque<TicketKey> m_keys; // Newest (encrypting) key first
+    std::atomic<std::int64_t> m_epoch{-1};
+
+    rz::services::SeriesId m_fullSeries = 0;
+    rz::services::SeriesId m_resumedSeries = 0;
+    rz::services::SeriesId m_issuedSeries = 0;
+    rz::services::SeriesId m_acceptedSeries = 0;
+    rz::services::SeriesId m_renewedSeries = 0;
+    rz::services::SeriesId m_unknownKeySeries = 0;
+    rz::services::SeriesId m_rotationSeries = 0;
+};
+
+} // namespace rz::utils
+
+#endif // CROW_ENABLE_SSL
@@ -0,0 +1,77 @@
+/**
+ * SPDX-FileComment: Request Tracing
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file trace.hpp
+ * @brief Lightweight per-request trace spans stored in thread-local buffers.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace rz::utils {
+
+/**
+ * @brief Collects the spans of the request currently handled by this thread.
+ *
+ * A request is traced from beginRequest() to endRequest() on the same thread.
+ * Spans are written into a fixed thread-local buffer (no allocation); the
+ * breakdown is only rendered when the request exceeded the slow threshold.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Reads TRACE_* configuration (call once at startup).
+     */
+    static void configure();
+
+    /**
+     * @brief Starts tracing a request on the calling thread.
+     * @param request_id Incoming X-Request-ID, or empty to generate one.
+     * @param route Route label (must outlive the request).
+     * @return std::uint64_t Generation token to pass to endRequest().
+     */
+    static std::uint64_t beginRequest(std::string_view request_id, std::string_view route);
+
+    /**
+     * @brief Finishes the request; emits the breakdown if it was slow.
+     * @param generation Token returned by beginRequest(); mismatches are ignored.
+     * @param status HTTP status code of the response.
+     */
+    static void endRequest(std::uint64_t generation, int status);
+
+    /**
+     * @brief The request ID of the request on this thread (empty if none).
+     */
+    [[nodiscard]] static std::string_view requestId();
+};
+
+/**
+ * @brief RAII span; a no-op when the thread is not tracing a request.
+ * @param name Static string (string literal) naming the span.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) noexcept;
+    ~TraceSpan();
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    int m_index;
+};
+
+} // namespace rz::utils
@@ -0,0 +1,79 @@
+/**
+ * SPDX-FileComment: Unix Socket Header
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file unix_socket.hpp
+ * @brief Path handling for the Unix domain socket listener.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <expected>
+#include <string>
+#include <string_view>
+
+namespace rz::utils {
+
+/**
+ * @brief Prepares and secures the filesystem path of a Unix domain socket.
+ *
+ * Crow binds the socket; this class handles what happens around it. Crow
+ * binds "<path>.new", which gets the configured mode and group (so a reverse
+ * proxy running as another user can connect) and is then renamed over the
+ * path. The rename replaces a stale file of a crashed server, and during a
+ * prefork rollover it hands the path from the old worker to its replacement
+ * without a moment where connects fail.
+ *
+ * Configuration:
+ * - SERVER_UNIX_SOCKET:       socket path (empty = no Unix socket listener)
+ * - SERVER_UNIX_SOCKET_MODE:  octal file mode, e.g. "0660"
+ * - SERVER_UNIX_SOCKET_GROUP: group owning the socket, e.g. "www-data"
+ * - SERVER_UNIX_SOCKET_ONLY:  true = do not listen on SERVER_PORT
+ */
+class UnixSocket {
+public:
+    /**
+     * @brief The socket path of one process; prefork workers get "<path>.<index>".
+     * @param path SERVER_UNIX_SOCKET.
+     * @param worker_index Prefork worker slot, or -1 in single-process mode.
+     */
+    static std::string pathFor(const std::string& path, int worker_index);
+
+    /**
+     * @brief Checks @p path and clears the temporary path Crow binds to.
+     * @param takeover True for prefork workers: a live listener is the worker this one replaces.
+     * @return The path to bind, or an error if a path is too long, is not a socket, or
+     * (without @p takeover) another server listens on @p path.
+     */
+    static std::expected<std::string, std::string> prepare(const std::string& path, bool takeover);
+
+    /**
+     * @brief Applies the mode and group to the bound socket file.
+     * @param mode Octal mode ("0660"); empty keeps the umask default.
+     * @param group Group name; empty keeps the process group.
+     */
+    static std::expected<void, std::string> secure(const std::string& path, std::string_view mode,
+                                                   const std::string& group);
+
+    /**
+     * @brief Atomically moves the bound and secured socket from @p bind_path to @p path.
+     */
+    static std::expected<void, std::string> publish(const std::string& bind_path, const std::string& path);
+
+    /**
+     * @brief Removes the socket file on shutdown, unless another process has replaced it since publish().
+     */
+    static void remove(const std::string& path);
+};
+
+} // namespace rz::utils
@@ -0,0 +1,190 @@
+/**
+ * SPDX-FileComment: Streaming Upload Helpers
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file upload_stream.hpp
+ * @brief Streams request bodies to a temp file with incremental SHA-256 and atomic publish.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct evp_md_ctx_st; // OpenSSL EVP_MD_CTX
+
+namespace rz::utils {
+
+/**
+ * @brief Metadata of a published upload.
+ */
+struct UploadResult {
+    std::string name;
+    std::filesystem::path path;
+    std::uintmax_t size;
+    std::string sha256;       // Hex digest of the stored bytes
+    std::string content_type; // Of the file part (multipart) or the request
+};
+
+/**
+ * @brief Incremental multipart/form-data scanner.
+ *
+ * Hands out spans of the first part with a filename, pointing into the
+ * caller's chunks; only a partial boundary (< 80 bytes) and the part headers
+ * are ever buffered.
+ */
+class MultipartScanner {
+public:
+    using DataFn = std::function<bool(std::string_view)>;
+
+    explicit MultipartScanner(std::string_view boundary);
+
+    /**
+     * @brief Consumes the next chunk of the body.
+     * @param chunk Raw body bytes.
+     * @param on_data Receives the file payload; returning false aborts.
+     * @return false if the body is malformed or @p on_data failed.
+     */
+    bool feed(std::string_view chunk, const DataFn& on_data);
+
+    [[nodiscard]] bool done() const { return m_state == State::Done; }
+    [[nodiscard]] bool foundFile() const { return m_foundFile; }
+    [[nodiscard]] const std::string& partContentType() const { return m_partContentType; }
+
+private:
+    enum class State { Preamble, AfterDelimiter, Headers, Body, Done };
+
+    bool emit(std::string_view data, const DataFn& on_data);
+    bool parsePartHeaders();
+
+    std::string m_delimiter; // "\r\n--" + boundary
+    std::size_t m_matched;   // Length of a delimiter prefix seen at the end of the last chunk
+    State m_state = State::Preamble;
+    std::string m_pending;   // Part headers, or the two bytes after a delimiter
+    bool m_inFile = false;
+    bool m_foundFile = false;
+    std::string m_partContentType;
+};
+
+/**
+ * @brief Receives one upload body: temp file, SHA-256 and size limit.
+ *
+ * Memory use is constant; each chunk is hashed and written with write(2).
+ */
+class UploadSink {
+public:
+    /**
+     * @brief Creates the temp file below UPLOAD_DIR.
+     * @param content_type Content-Type of the request (multipart/form-data is parsed).
+     * @param content_length Announced body size, or UINT64_MAX if unknown (chunked).
+     */
+    static std::expected<std::unique_ptr<UploadSink>, std::string> create(std::string_view content_type,
+                                                                          std::uint64_t content_length);
+
+    ~UploadSink();
+    UploadSink(const UploadSink&) = delete;
+    UploadSink& operator=(const UploadSink&) = delete;
+
+    /**
+     * @brief Consumes the next body chunk. Errors are latched and reported by commit().
+     */
+    void write(const char* data, std::size_t length);
+
+    /**
+     * @brief Syncs the temp file and renames it to UPLOAD_DIR/<name> (atomic replace).
+     */
+    std::expected<UploadResult, std::string> commit(std::string_view name);
+
+    [[nodiscard]] bool tooLarge() const { return m_tooLarge; }
+    [[nodiscard]] bool malformed() const { return m_malformed; }
+
+private:
+    UploadSink(int fd, std::filesystem::path temp_path, std::string content_type, std::uint64_t limit);
+    bool append(std::string_view data);
+
+    int m_fd;
+    std::filesystem::path m_tempPath;
+    std::string m_contentType;
+    std::unique_ptr<MultipartScanner> m_multipart;
+    struct ShaDeleter {
+        void operator()(evp_md_ctx_st* ctx) const;
+    };
+    std::unique_ptr<evp_md_ctx_st, ShaDeleter> m_sha;
+    std::uint64_t m_limit;
+    std::uint64_t m_received = 0;
+    std::uint64_t m_written = 0;
+    bool m_tooLarge = false;
+    bool m_malformed = false;
+    std::string m_error;
+    bool m_committed = false;
+};
+
+/**
+ * @brief Configuration of the upload path and the per-thread hand-off from the
+ * (patched) Crow parser to the route handler.
+ */
+class UploadStream {
+public:
+    /**
+     * @brief Reads UPLOAD_DIR / UPLOAD_MAX_BYTES, creates the directories and
+     * removes temp files left behind by aborted uploads.
+     */
+    static std::expected<void, std::string> configure();
+
+    /**
+     * @brief Returns the sink that received the body of the request currently
+     * handled on this thread, or nullptr if the body was buffered by Crow.
+     */
+    static std::unique_ptr<UploadSink> take();
+
+    /**
+     * @brief True if the body streams while it is received (Crow parser patch present).
+     */
+    static bool streaming();
+
+    /**
+     * @brief Validates a file name from the URL (no separators, no leading dot).
+     */
+    static bool isValidName(std::string_view name);
+
+    static const std::filesystem::path& directory();
+    static std::uint64_t maxBytes();
+};
+
+/**
+ * @brief Callbacks injected into Crow's HTTP parser by cmake/crow_upload_stream.cmake.
+ *
+ * Each connection is parsed on one I/O thread, so state is kept thread-local
+ * and keyed by the parser address. Only POST/PUT to /api/uploads/ are claimed.
+ * onBody() returns 1 for a consumed chunk, 0 to leave it to Crow and -1 to
+ * reject the request with rejection() and close the connection. onClose() runs
+ * from the connection destructor and drops the state of an unfinished upload.
+ */
+namespace upload_hooks {
+void onUrl(const void* parser, const char* at, std::size_t length);
+void onHeaderField(const void* parser, const char* at, std::size_t length);
+void onHeaderValue(const void* parser, const char* at, std::size_t length);
+void onHeadersComplete(const void* parser, unsigned int method, std::uint64_t content_length);
+int onBody(const void* parser, const char* at, std::size_t length);
+void onMessageComplete(const void* parser);
+void onClose(const void* parser);
+const std::string& rejection();
+} // namespace upload_hooks
+
+} // namespace rz::utils
@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+# file: scripts/pgo_build.sh
+# brief: Profile-guided + link-time optimized release build.
+# version: 0.1.0
+# date: 2026-10-18
+# author: ZHENG Robert
+#
+# usage: scripts/pgo_build.sh [build-dir] [training seconds]
+#
+# 1. configures an instrumented build (RZ_PGO=GENERATE) and builds it
+# 2. runs pgo_train against it, which writes the profile
+# 3. reconfigures the same build tree with RZ_PGO=USE and LTO and rebuilds
+#
+# Extra CMake arguments can be passed through PGO_CMAKE_ARGS, e.g.
+#   PGO_CMAKE_ARGS="-DRZ_LTO_DEPENDENCIES=ON" scripts/pgo_build.sh
+
+set -euo pipefail
+
+SOURCE_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+BUILD_DIR="${1:-${SOURCE_DIR}/build-pgo}"
+TRAIN_SECONDS="${2:-30}"
+PROFILE_DIR="${BUILD_DIR}/pgo-profile"
+JOBS="$(nproc)"
+read -r -a EXTRA_ARGS <<< "${PGO_CMAKE_ARGS:-}"
+
+echo "==> [1/3] Instrumented build in ${BUILD_DIR}"
+rm -rf "${PROFILE_DIR}"
+cmake -S "${SOURCE_DIR}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release \
+    -DRZ_PGO=GENERATE -DRZ_PGO_PROFILE_DIR="${PROFILE_DIR}" -DRZ_LTO=OFF "${EXTRA_ARGS[@]}"
+cmake --build "${BUILD_DIR}" -j"${JOBS}" --target pgo_train
+
+echo "==> [2/3] Training for ${TRAIN_SECONDS} s"
+"${BUILD_DIR}/pgo_train" --duration "${TRAIN_SECONDS}" --threads 4
+
+echo "==> [3/3] Optimized build (profile + LTO)"
+cmake -S "${SOURCE_DIR}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release \
+    -DRZ_PGO=USE -DRZ_PGO_PROFILE_DIR="${PROFILE_DIR}" -DRZ_LTO=ON "${EXTRA_ARGS[@]}"
+cmake --build "${BUILD_DIR}" -j"${JOBS}"
+
+echo "==> Done: ${BUILD_DIR}/CPPAppServer"
@@ -0,0 +1,35 @@
+/**
+ * SPDX-FileComment: Event Controller Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file event_controller.cpp
+ * @brief Implementation of EventController routes.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "controllers/event_controller.hpp"
+#include "services/event_hub.hpp"
+#include "utils/route_registry.hpp"
+
+namespace rz::controllers {
+
+void EventController::registerRoutes(rz::App& app) {
+    rz::services::EventHub::getInstance().configure();
+
+    // SSE stream window; the response is completed asynchronously by the hub
+    RZ_ROUTE(app, "/api/events/stream")
+    ([](const crow::request& req, crow::response& res) {
+        rz::services::EventHub::getInstance().subscribe(req, res);
+    });
+}
+
+} // namespace rz::controllers
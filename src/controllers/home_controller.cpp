@@ -7,8 +7,8 @@
  *
  * @file home_controller.cpp
  * @brief Implementation of HomeController routes.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.2
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -17,27 +17,40 @@
  */
 
 #include "controllers/home_controller.hpp"
-#include <nlohmann/json.hpp>
 #include "rz_config.hpp" // For version info
+#include "utils/http_cache.hpp"
+#include "utils/json_writer.hpp"
+#include "utils/route_registry.hpp"
 
 namespace rz::controllers {
 
-void HomeController::registerRoutes(crow::SimpleApp& app) {
+namespace {
+
+// The root payload only depends on build-time constants, so it is serialized once.
+rz::utils::CachedResponsePtr buildRootResponse() {
+    rz::utils::JsonWriter json;
+    json.beginObject()
+        .field<"app">(rz::config::PROG_LONGNAME)
+        .field<"version">(rz::config::VERSION)
+        .field<"status">("running")
+        .field<"message">("Welcome to the CPP App Server")
+        .endObject();
+
+    return std::make_shared<const rz::utils::CachedResponse>(json.take(), "application/json");
+}
+
+} // namespace
+
+void HomeController::registerRoutes(rz::App& app) {
     
     // Root endpoint
-    CROW_ROUTE(app, "/")
-    ([]() {
-        nlohmann::json response;
-        response["app"] = rz::config::PROG_LONGNAME;
-        response["version"] = rz::config::VERSION;
-        response["status"] = "running";
-        response["message"] = "Welcome to the CPP App Server";
-        
-        return crow::response(response.dump());
+    RZ_ROUTE(app, "/")
+    ([root = buildRootResponse()](const crow::request& req) {
+        return root->serve(req);
     });
 
     // Status endpoint
-    CROW_ROUTE(app, "/status")
+    RZ_ROUTE(app, "/status")
     ([]() {
         return crow::response(200, "OK");
     });
@@ -0,0 +1,76 @@
+/**
+ * SPDX-FileComment: Push Controller Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file push_controller.cpp
+ * @brief Implementation of PushController routes.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "controllers/push_controller.hpp"
+#include "services/push_service.hpp"
+#include "utils/token_utils.hpp"
+#include <spdlog/spdlog.h>
+
+namespace rz::controllers {
+
+namespace {
+
+// Browsers cannot set headers on a WebSocket handshake, so the JWT may also come as ?token=
+std::string extractToken(const crow::request& req) {
+    std::string auth = req.get_header_value("Authorization");
+    if (auth.starts_with("Bearer ")) {
+        return auth.substr(7);
+    }
+    if (const char* token = req.url_params.get("token")) {
+        return token;
+    }
+    return {};
+}
+
+} // namespace
+
+void PushController::registerRoutes(rz::App& app) {
+    rz::services::PushService::getInstance().configure();
+
+    // The user UUID from the JWT lives as connection userdata until onclose
+    CROW_WEBSOCKET_ROUTE(app, "/api/push")
+        .max_payload(4096)
+        .onaccept([](const crow::request& req, void** userdata) {
+            auto payload = rz::utils::TokenUtils::verifyToken(extractToken(req));
+            if (!payload) {
+                return false;
+            }
+            *userdata = new std::string(payload->userId);
+            return true;
+        })
+        .onopen([](crow::websocket::connection& conn) {
+            auto* user_uuid = static_cast<std::string*>(conn.userdata());
+            if (!rz::services::PushService::getInstance().add(*user_uuid, &conn)) {
+                conn.close("Too many connections", 1008);
+                return;
+            }
+            spdlog::debug("Push socket opened for user {}", *user_uuid);
+        })
+        .onclose([](crow::websocket::connection& conn, const std::string& /*reason*/, auto&&...) {
+            auto* user_uuid = static_cast<std::string*>(conn.userdata());
+            if (!user_uuid) return;
+            rz::services::PushService::getInstance().remove(*user_uuid, &conn);
+            conn.userdata(nullptr);
+            delete user_uuid;
+        })
+        .onmessage([](crow::websocket::connection&, const std::string&, bool) {
+            // Server-to-client channel; client messages are ignored
+        });
+}
+
+} // namespace rz::controllers
@@ -0,0 +1,36 @@
+/**
+ * SPDX-FileComment: Static Controller Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file static_controller.cpp
+ * @brief Implementation of StaticController routes.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "controllers/static_controller.hpp"
+#include "services/static_file_service.hpp"
+#include "utils/route_registry.hpp"
+
+namespace rz::controllers {
+
+void StaticController::registerRoutes(rz::App& app) {
+    rz::services::StaticFileService::getInstance().configure();
+
+    // Static assets (replaces Crow's built-in static route, see CROW_DISABLE_STATIC_DIR)
+    RZ_ROUTE(app, "/static/<path>")
+    ([](const crow::request& req, crow::response& res, std::string path) {
+        rz::services::StaticFileService::getInstance().serve(req, res, path);
+        res.end();
+    });
+}
+
+} // namespace rz::controllers
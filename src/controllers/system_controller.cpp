@@ -7,8 +7,8 @@
  *
  * @file system_controller.cpp
  * @brief Implementation of SystemController routes.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.7
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -18,68 +18,138 @@
 
 #include "controllers/system_controller.hpp"
 #include "rz_config.hpp"
+#include "utils/allocator_stats.hpp"
 #include "utils/app_config.hpp"
 #include "services/notification_service.hpp"
 #include "services/database_service.hpp"
-#include <chrono>
-#include <iomanip>
+#include "services/health_service.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/http_cache.hpp"
+#include "utils/json_writer.hpp"
+#include "utils/memory_accounting.hpp"
+#include "utils/route_registry.hpp"
+#include "utils/startup_profiler.hpp"
 #include <nlohmann/json.hpp>
-#include <sstream>
 
 namespace rz::controllers {
 
-void SystemController::registerRoutes(crow::SimpleApp &app) {
+namespace {
+
+// Every field is a build-time constant from rz_config.hpp.
+rz::utils::CachedResponsePtr buildSystemInfoResponse() {
+  rz::utils::JsonWriter json(1024);
+  json.beginObject();
+
+  // Project Info
+  json.key<"project">()
+      .beginObject()
+      .field<"name">(rz::config::PROJECT_NAME)
+      .field<"long_name">(rz::config::PROG_LONGNAME)
+      .field<"description">(rz::config::PROJECT_DESCRIPTION)
+      .field<"license">(rz::config::PROG_LICENSE)
+      .field<"executable">(rz::config::EXECUTABLE_NAME)
+      .field<"homepage">(rz::config::PROJECT_HOMEPAGE_URL)
+      .endObject();
+
+  // Version Info
+  json.key<"version">()
+      .beginObject()
+      .field<"full">(rz::config::VERSION)
+      .field<"major">(rz::config::PROJECT_VERSION_MAJOR)
+      .field<"minor">(rz::config::PROJECT_VERSION_MINOR)
+      .field<"patch">(rz::config::PROJECT_VERSION_PATCH)
+      .endObject();
+
+  // Author / Organization
+  json.key<"author">()
+      .beginObject()
+      .field<"name">(rz::config::AUTHOR)
+      .field<"organization">(rz::config::ORGANIZATION)
+      .field<"domain">(rz::config::DOMAIN)
+      .field<"created_year">(rz::config::CREATED_YEAR)
+      .endObject();
+
+  // Build Info
+  json.key<"build">()
+      .beginObject()
+      .field<"std">(rz::config::CMAKE_CXX_STANDARD)
+      .field<"compiler">(rz::config::CMAKE_CXX_COMPILER)
+      .endObject();
+
+  json.endObject();
+  return std::make_shared<const rz::utils::CachedResponse>(json.take(),
+                                                           "application/json");
+}
+
+} // namespace
+
+void SystemController::registerRoutes(rz::App &app) {
+
+  // Health Check Endpoint (serves the latest snapshot of the background prober)
+  RZ_ROUTE(app, "/system/health_check")
+  ([]() {
+    auto snapshot = rz::services::HealthService::getInstance().snapshot();
+    crow::response res(snapshot->http_code, snapshot->body);
+    res.set_header("Content-Type", "application/json");
+    res.set_header("Cache-Control", "no-store");
+    return res;
+  });
 
-  // Health Check Endpoint
-  CROW_ROUTE(app, "/system/health_check")
+  // Readiness: startup finished and the latest probe is healthy (liveness stays on /system/health_check)
+  RZ_ROUTE(app, "/system/ready")
   ([]() {
-    nlohmann::json response;
-    response["status"] = "ok";
+    auto& profiler = rz::utils::StartupProfiler::getInstance();
+    auto snapshot = rz::services::HealthService::getInstance().snapshot();
+    bool ready = profiler.ready() && snapshot->http_code == 200;
+
+    rz::utils::JsonWriter json(512);
+    json.beginObject()
+        .field<"ready">(ready)
+        .field<"status">(snapshot->status)
+        .key<"startup">()
+        .raw(profiler.toJson())
+        .endObject();
+    crow::response res(ready ? 200 : 503, json.take());
+    res.set_header("Content-Type", "application/json");
+    res.set_header("Cache-Control", "no-store");
+    return res;
+  });
 
-    // Simple timestamp for the health check
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S");
-    response["timestamp"] = ss.str();
+  // Heap statistics of the linked allocator, with the per-arena breakdown
+  RZ_ROUTE(app, "/system/allocator")
+  ([]() {
+    crow::response res(200, rz::utils::AllocatorStats::getInstance().toJson());
+    res.set_header("Content-Type", "application/json");
+    res.set_header("Cache-Control", "no-store");
+    return res;
+  });
 
-    return crow::response(response.dump());
+  // Memory held per subsystem, with peaks and soft limits
+  RZ_ROUTE(app, "/system/memory")
+  ([]() {
+    crow::response res(200, rz::utils::MemoryAccounting::getInstance().toJson());
+    res.set_header("Content-Type", "application/json");
+    res.set_header("Cache-Control", "no-store");
+    return res;
   });
 
-  // System Info Endpoint
-  CROW_ROUTE(app, "/system/system_info")
+  // Prometheus scrape endpoint (shards are only aggregated here)
+  RZ_ROUTE(app, "/metrics")
   ([]() {
-    nlohmann::json response;
-
-    // Project Info
-    response["project"]["name"] = rz::config::PROJECT_NAME;
-    response["project"]["long_name"] = rz::config::PROG_LONGNAME;
-    response["project"]["description"] = rz::config::PROJECT_DESCRIPTION;
-    response["project"]["license"] = rz::config::PROG_LICENSE;
-    response["project"]["executable"] = rz::config::EXECUTABLE_NAME;
-    response["project"]["homepage"] = rz::config::PROJECT_HOMEPAGE_URL;
-
-    // Version Info
-    response["version"]["full"] = rz::config::VERSION;
-    response["version"]["major"] = rz::config::PROJECT_VERSION_MAJOR;
-    response["version"]["minor"] = rz::config::PROJECT_VERSION_MINOR;
-    response["version"]["patch"] = rz::config::PROJECT_VERSION_PATCH;
-
-    // Author / Organization
-    response["author"]["name"] = rz::config::AUTHOR;
-    response["author"]["organization"] = rz::config::ORGANIZATION;
-    response["author"]["domain"] = rz::config::DOMAIN;
-    response["author"]["created_year"] = rz::config::CREATED_YEAR;
-
-    // Build Info
-    response["build"]["std"] = rz::config::CMAKE_CXX_STANDARD;
-    response["build"]["compiler"] = rz::config::CMAKE_CXX_COMPILER;
-
-    return crow::response(response.dump());
+    crow::response res(200, rz::services::MetricsService::getInstance().scrape());
+    res.set_header("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+    return res;
+  });
+
+  // System Info Endpoint (serialized once, revalidated via ETag)
+  RZ_ROUTE(app, "/system/system_info")
+  ([info = buildSystemInfoResponse()](const crow::request &req) {
+    return info->serve(req);
   });
 
-    // Test Email Route
-    CROW_ROUTE(app, "/system/test_email")
+    // Test Email Route (blocks on DB and SMTP, so only a few may run at once)
+    RZ_ROUTE_BULKHEAD(app, "/system/test_email",
+                      rz::utils::AppConfig::getInstance().getInt("BULKHEAD_TEST_EMAIL", 2))
     ([]() {
         auto& db = rz::services::DatabaseService::getInstance();
         auto& config = rz::utils::AppConfig::getInstance();
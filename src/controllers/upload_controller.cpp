@@ -0,0 +1,75 @@
+/**
+ * SPDX-FileComment: Upload Controller Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file upload_controller.cpp
+ * @brief Implementation of UploadController routes.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "controllers/upload_controller.hpp"
+#include "utils/json_writer.hpp"
+#include "utils/route_registry.hpp"
+#include "utils/trace.hpp"
+#include "utils/upload_stream.hpp"
+#include <spdlog/spdlog.h>
+
+namespace rz::controllers {
+
+void UploadController::registerRoutes(rz::App& app) {
+    if (auto res = rz::utils::UploadStream::configure(); !res) {
+        spdlog::error("Upload directory unavailable: {}", res.error());
+    }
+
+    // Raw body or multipart/form-data (first file part). With the Crow parser
+    // patch the body has already been streamed to a temp file at this point.
+    RZ_ROUTE(app, "/api/uploads/<string>")
+        .methods(crow::HTTPMethod::Post, crow::HTTPMethod::Put)
+    ([](const crow::request& req, std::string name) {
+        rz::utils::TraceSpan span("upload.commit");
+
+        auto sink = rz::utils::UploadStream::take();
+        if (!sink) {
+            // Buffered fallback: Crow already holds the whole body in memory
+            auto created = rz::utils::UploadSink::create(req.get_header_value("Content-Type"), req.body.size());
+            if (!created) {
+                return crow::response(500, created.error());
+            }
+            sink = std::move(*created);
+            sink->write(req.body.data(), req.body.size());
+        }
+
+        if (!rz::utils::UploadStream::isValidName(name)) {
+            return crow::response(400, "Invalid file name");
+        }
+        if (sink->tooLarge()) {
+            return crow::response(413, "Upload exceeds " + std::to_string(rz::utils::UploadStream::maxBytes()) + " bytes");
+        }
+
+        auto result = sink->commit(name);
+        if (!result) {
+            return crow::response(sink->malformed() ? 400 : 500, result.error());
+        }
+        spdlog::info("Upload stored: {} ({} bytes, sha256 {})", result->path.string(), result->size, result->sha256);
+
+        rz::utils::JsonWriter json;
+        json.beginObject()
+            .field<"name">(result->name)
+            .field<"size">(result->size)
+            .field<"sha256">(result->sha256)
+            .field<"content_type">(result->content_type)
+            .endObject();
+        return json.response(201);
+    });
+}
+
+} // namespace rz::controllers
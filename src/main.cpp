@@ -7,8 +7,8 @@
  *
  * @file main.cpp
  * @brief Main entry point for the C++23 Crow Webserver.
- * @version 0.1.2
- * @date 2026-01-31
+ * @version 0.2.18
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -18,8 +18,6 @@
 
 #include <crow.h>
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/rotating_file_sink.h>
 #include <print>
 #include <filesystem>
 #include <chrono>
@@ -27,12 +25,36 @@
 #include <sstream>
 #include <csignal>
 #include <functional>
+#include <expected>
+#include <algorithm>
+#include <format>
+#include <future>
+#include <memory>
+#include <vector>
+#include <unistd.h>
 
 #include "rz_config.hpp"
+#include "app.hpp"
 #include "utils/app_config.hpp"
+#include "utils/logging_utils.hpp"
+#include "utils/trace.hpp"
+#include "utils/prefork_supervisor.hpp"
+#include "utils/cpu_affinity.hpp"
+#include "utils/unix_socket.hpp"
+#include "utils/tls_context.hpp"
+#include "utils/startup_profiler.hpp"
+#include "utils/allocator_stats.hpp"
+#include "utils/memory_accounting.hpp"
+#include "utils/middleware_setup.hpp"
 #include "controllers/home_controller.hpp"
 #include "controllers/system_controller.hpp"
+#include "controllers/static_controller.hpp"
+#include "controllers/upload_controller.hpp"
+#include "controllers/event_controller.hpp"
+#include "controllers/push_controller.hpp"
 #include "services/database_service.hpp" // Added include
+#include "services/health_service.hpp"
+#include "services/smtp_service.hpp"
 
 namespace fs = std::filesystem;
 
@@ -55,11 +77,23 @@ std::string get_current_time_str() {
     return ss.str();
 }
 
-int main() {
-    // 1. Load Configuration First
+/**
+ * @brief Runs one server instance: the whole process, or one prefork worker.
+ * @param env_file Path of the loaded .env file (for the startup log).
+ * @param config_result Result of loading the .env file.
+ * @param worker_index Prefork worker slot, or -1 in single-process mode.
+ * @param ready_fd Readiness pipe to the prefork supervisor, or -1.
+ * @return int Process exit code.
+ */
+int run_server(const std::string& env_file,
+               const std::expected<void, std::string>& config_result,
+               int worker_index, int ready_fd) {
     auto& config = rz::utils::AppConfig::getInstance();
-    const std::string env_file = "data/CPPAppServer.env";
-    auto config_result = config.load(env_file);
+    auto& profiler = rz::utils::StartupProfiler::getInstance();
+    if (worker_index >= 0) {
+        // A forked worker measures its own time to ready
+        profiler.begin();
+    }
 
     // 2. Logging Setup
     std::string logDir = config.getString("LOG_DIR", "./data/logs");
@@ -68,6 +102,7 @@ int main() {
 
     // Ensure log directory exists
     try {
+        auto phase = profiler.phase("log_directory");
         if (!fs::exists(logDir)) {
             fs::create_directories(logDir);
         }
@@ -76,32 +111,31 @@ int main() {
         return 1;
     }
 
-    std::string logFile = logDir + "/" + projName + ".log";
+    // Prefork workers write separate files; the rotating sink is not multi-process safe
+    std::string logFile = logDir + "/" + projName +
+                          (worker_index >= 0 ? ".worker" + std::to_string(worker_index) : "") + ".log";
 
-    try {
-        auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-        auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(logFile, 1024 * 1024 * 5, 3);
-        
-        std::vector<spdlog::sink_ptr> sinks {console_sink, file_sink};
-        auto logger = std::make_shared<spdlog::logger>("multi_sink", sinks.begin(), sinks.end());
-        
-        logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
-        spdlog::set_default_logger(logger);
-
-        if (logLevelStr == "debug") spdlog::set_level(spdlog::level::debug);
-        else if (logLevelStr == "warn") spdlog::set_level(spdlog::level::warn);
-        else if (logLevelStr == "error") spdlog::set_level(spdlog::level::err);
-        else spdlog::set_level(spdlog::level::info);
-
-        // Flush on Error AND periodically every 3 seconds
-        spdlog::flush_on(spdlog::level::err);
-        spdlog::flush_every(std::chrono::seconds(3));
-
-        spdlog::info("Logging initialized. Level: {}, File: {}", logLevelStr, logFile);
-
-    } catch (const spdlog::spdlog_ex &ex) {
-        std::cerr << "Log initialization failed: " << ex.what() << std::endl;
-        return 1;
+    // Threads started from here on (logger, flusher, prober) inherit the background CPU set
+    auto affinity_result = rz::utils::CpuAffinity::configure(worker_index);
+    rz::utils::CpuAffinity::applyBackground();
+
+    auto log_options = rz::utils::LoggingUtils::optionsFromConfig(logFile);
+    {
+        auto phase = profiler.phase("logging");
+        if (auto res = rz::utils::LoggingUtils::init(log_options); !res) {
+            std::cerr << res.error() << std::endl;
+            return 1;
+        }
+    }
+    spdlog::info("Logging initialized. Level: {}, File: {}, Mode: {}", logLevelStr, logFile,
+                 log_options.async ? (log_options.drop_oldest ? "async (drop oldest)" : "async (block)") : "sync");
+
+    rz::utils::Tracer::configure();
+
+    if (!affinity_result) {
+        spdlog::error("CPU affinity disabled: {}", affinity_result.error());
+    } else {
+        spdlog::info("CPU affinity: {}", rz::utils::CpuAffinity::describe());
     }
 
     // --- STARTUP LOGS ---
@@ -114,53 +148,244 @@ int main() {
          spdlog::info("Using Configuration File: {}", env_file);
     }
 
-    // 3. Initialize Database
-    if (auto res = rz::services::DatabaseService::getInstance().init(); !res) {
-        spdlog::error("Database Initialization Failed: {}", res.error());
+    // Limits are read before the subsystems register (SQLite applies its own at open)
+    rz::utils::MemoryAccounting::getInstance().configure();
+    // The enforcement thread calls into other singletons; stop it on every return, before static destruction
+    struct MemoryAccountingStop {
+        ~MemoryAccountingStop() { rz::utils::MemoryAccounting::getInstance().stop(); }
+    } memory_accounting_stop;
+
+    // 3. Independent subsystems initialize concurrently: the database (followed by the
+    // health prober, whose first round also connects to the SMTP relay), the email
+    // templates, and the middleware and routes on this thread
+    auto database = std::async(std::launch::async, [&profiler]() -> std::expected<void, std::string> {
+        {
+            auto phase = profiler.phase("database");
+            if (auto res = rz::services::DatabaseService::getInstance().init(); !res) return res;
+        }
+        // Health checks are probed in the background; the endpoint only reads the snapshot
+        rz::services::HealthService::getInstance().start();
+        return {};
+    });
+    auto templates = std::async(std::launch::async, [&profiler] {
+        auto phase = profiler.phase("templates");
+        return rz::services::SmtpService::preloadTemplates();
+    });
+
+    // Middleware state is configured before the I/O threads exist
+    {
+        auto phase = profiler.phase("middleware");
+        rz::utils::MiddlewareSetup::configure();
+        // Registers the allocator gauges
+        rz::utils::AllocatorStats::getInstance();
+    }
+    spdlog::info("Allocator: {}", rz::utils::AllocatorStats::name());
+    auto routes_phase = profiler.phase("routes");
+
+    // 4. Setup Crow Applications: a Crow app listens on TCP or on a Unix socket, so each listener gets one
+    std::string unix_path = rz::utils::UnixSocket::pathFor(config.getString("SERVER_UNIX_SOCKET", ""), worker_index);
+    auto unix_only = config.getBool("SERVER_UNIX_SOCKET_ONLY", false);
+    if (!unix_only) {
+        spdlog::error("Unix socket: {}", unix_only.error());
         return 1;
     }
+    bool tcp_enabled = unix_path.empty() || !*unix_only;
+    std::string unix_bind_path;
+    if (!unix_path.empty()) {
+        // A prefork worker replaces the previous worker of its slot, which may still be listening
+        auto res = rz::utils::UnixSocket::prepare(unix_path, worker_index >= 0);
+        if (!res) {
+            spdlog::error("Unix socket: {}", res.error());
+            return 1;
+        }
+        unix_bind_path = std::move(*res);
+    }
+    std::unique_ptr<rz::App> tcp_app = tcp_enabled ? std::make_unique<rz::App>() : nullptr;
+    std::unique_ptr<rz::App> unix_app = unix_path.empty() ? nullptr : std::make_unique<rz::App>();
 
-    // 4. Setup Crow Application
-    crow::SimpleApp app;
+    // 5. Register Controllers / Routes (the route registry is shared, declaring twice is harmless)
+    for (rz::App* app : {tcp_app.get(), unix_app.get()}) {
+        if (!app) continue;
+        rz::controllers::HomeController::registerRoutes(*app);
+        rz::controllers::SystemController::registerRoutes(*app);
+        rz::controllers::StaticController::registerRoutes(*app);
+        rz::controllers::UploadController::registerRoutes(*app);
+        rz::controllers::EventController::registerRoutes(*app);
+        rz::controllers::PushController::registerRoutes(*app);
+        app->loglevel(logLevelStr == "debug" ? crow::LogLevel::Debug : crow::LogLevel::Info);
+    }
 
-    // 5. Register Controllers / Routes
-    rz::controllers::HomeController::registerRoutes(app);
-    rz::controllers::SystemController::registerRoutes(app);
+    // Policies refer to route patterns, so the limiters are configured once all routes are declared
+    rz::utils::MiddlewareSetup::configurePolicies();
+    routes_phase.end();
 
     // 5. Configure App Settings
     uint16_t port = config.getServerPort();
     uint16_t threads = config.getServerThreads();
-    
-    if (logLevelStr == "debug") {
-        app.loglevel(crow::LogLevel::Debug);
-    } else {
-        app.loglevel(crow::LogLevel::Info);
+    if (threads == 0 && rz::utils::CpuAffinity::enabled()) {
+        // One I/O thread per CPU of the I/O set
+        threads = static_cast<uint16_t>(rz::utils::CpuAffinity::ioCpus().size());
+    }
+
+    // HTTPS on the TCP listener; the Unix socket is only reachable by the local proxy
+    bool tls = false;
+    auto tls_enabled = config.getBool("TLS_ENABLED", false);
+    if (!tls_enabled) {
+        // A typo must not silently start a plaintext listener
+        spdlog::error("TLS: {}", tls_enabled.error());
+        return 1;
+    }
+#ifdef CROW_ENABLE_SSL
+    if (tcp_app && *tls_enabled) {
+        auto phase = profiler.phase("tls");
+        auto context = rz::utils::TlsContext::getInstance().create();
+        if (!context) {
+            spdlog::error("TLS: {}", context.error());
+            return 1;
+        }
+        tcp_app->ssl(std::move(*context));
+        tls = true;
+    }
+#else
+    if (tcp_app && *tls_enabled) {
+        spdlog::error("TLS: TLS_ENABLED is set, but this build has no TLS support");
+        return 1;
+    }
+#endif
+
+    // Join the background initialization
+    {
+        auto phase = profiler.phase("join");
+        if (auto res = database.get(); !res) {
+            spdlog::error("Database Initialization Failed: {}", res.error());
+            return 1;
+        }
+        if (auto res = templates.get(); !res) {
+            spdlog::warn("Template preload: {}", res.error());
+        } else {
+            spdlog::info("Preloaded {} email templates", *res);
+        }
     }
 
     // 6. Signal Handling Setup
     g_shutdown_handler = [&](int signum) {
         spdlog::info("Interrupt signal ({}) received. Stopping server...", signum);
-        app.stop();
+        if (tcp_app) tcp_app->stop();
+        if (unix_app) unix_app->stop();
     };
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
 
-    spdlog::info("Server listening on port {}", port);
+    std::string listeners;
+    if (tcp_app) listeners = std::format("port {}{}", port, tls ? " (TLS)" : "");
+    if (unix_app) listeners += std::format("{}unix socket {}", listeners.empty() ? "" : " and ", unix_path);
+    if (worker_index >= 0) {
+        spdlog::info("Prefork worker {} (pid {}) listening on {}", worker_index, ::getpid(), listeners);
+    } else {
+        spdlog::info("Server listening on {}", listeners);
+    }
 
     // 7. Run Server
-    auto& app_runner = app.port(port).multithreaded();
-    if (threads > 0) {
-        app_runner.concurrency(threads);
+    auto listen_phase = profiler.phase("listen");
+    // Crow's threads inherit the I/O set and are pinned once they exist
+    auto threads_before = rz::utils::CpuAffinity::threadIds();
+    rz::utils::CpuAffinity::applyIo();
+    std::vector<std::future<void>> servers;
+    bool listener_failed = false;
+    if (tcp_app) {
+        auto& app_runner = tcp_app->port(port).multithreaded();
+        if (threads > 0) {
+            app_runner.concurrency(threads);
+        }
+        servers.push_back(app_runner.run_async());
+        tcp_app->wait_for_server_start();
     }
-    app_runner.run();
+    if (unix_app) {
+        auto& app_runner = unix_app->local_socket_path(unix_bind_path).multithreaded();
+        if (threads > 0) {
+            app_runner.concurrency(threads);
+        }
+        servers.push_back(app_runner.run_async());
+        unix_app->wait_for_server_start();
+        // Crow binds with the umask mode; connecting needs write access, so 0755 admits only the owner until now
+        if (auto res = rz::utils::UnixSocket::secure(unix_bind_path,
+                                                     config.getString("SERVER_UNIX_SOCKET_MODE", "0660"),
+                                                     config.getString("SERVER_UNIX_SOCKET_GROUP", ""));
+            !res) {
+            // Never publish a socket with the wrong owner or mode
+            spdlog::error("Unix socket: {}", res.error());
+            ::unlink(unix_bind_path.c_str());
+            listener_failed = true;
+        } else if (auto published = rz::utils::UnixSocket::publish(unix_bind_path, unix_path); !published) {
+            spdlog::error("Unix socket: {}", published.error());
+            listener_failed = true;
+        }
+    }
+    if (listener_failed) {
+        // Not ready: the supervisor keeps the old worker, a single server exits
+        if (tcp_app) tcp_app->stop();
+        if (unix_app) unix_app->stop();
+    }
+    if (auto pinned = rz::utils::CpuAffinity::pinNewIoThreads(threads_before); pinned > 0) {
+        spdlog::info("CPU affinity: pinned {} Crow threads", pinned);
+    }
+    listen_phase.end();
+
+    // Ready once warm: the first probe round has touched SQLite, the SMTP relay and the templates
+    if (!listener_failed) {
+        auto phase = profiler.phase("warmup");
+        auto timeout = std::chrono::milliseconds(std::max(0, config.getInt("STARTUP_WARMUP_TIMEOUT_MS", 10000)));
+        if (!rz::services::HealthService::getInstance().waitForFirstProbe(timeout)) {
+            spdlog::warn("First health probe did not finish within {} ms", timeout.count());
+        }
+        phase.end();
+        profiler.markReady();
+        rz::utils::PreforkSupervisor::notifyReady(ready_fd);
+    }
+    for (auto& server : servers) {
+        server.get();
+    }
+    rz::utils::UnixSocket::remove(unix_path);
+
+    rz::services::HealthService::getInstance().stop();
 
     // 8. Shutdown Logs
-    int exitCode = 0; // Assuming clean exit if run() returns
+    int exitCode = listener_failed ? 1 : 0;
     spdlog::info("Server End Time: {}", get_current_time_str());
     spdlog::info("Server shutting down with code: {}", exitCode);
 
-    // IMPORTANT: Flush logs immediately now
-    spdlog::shutdown();
+    // IMPORTANT: Flush logs immediately now (drains the async queue)
+    rz::utils::LoggingUtils::shutdown();
 
     return exitCode;
 }
+
+int main() {
+    // 1. Load Configuration First
+    auto& profiler = rz::utils::StartupProfiler::getInstance();
+    profiler.begin();
+
+    auto& config = rz::utils::AppConfig::getInstance();
+    const std::string env_file = "data/CPPAppServer.env";
+    std::expected<void, std::string> config_result;
+    {
+        auto phase = profiler.phase("config");
+        config_result = config.load(env_file);
+    }
+
+    // Prefork mode: the supervisor forks the workers before any thread exists
+    unsigned workers = static_cast<unsigned>(std::max(1, config.getInt("SERVER_WORKERS", 1)));
+    if (workers > 1) {
+#ifdef RZ_HAVE_REUSEPORT
+        rz::utils::PreforkSupervisor supervisor(workers);
+        return supervisor.run([&](unsigned index, int ready_fd) {
+            return run_server(env_file, config_result, static_cast<int>(index), ready_fd);
+        });
+#else
+        std::cerr << "SERVER_WORKERS > 1 requires the Crow SO_REUSEPORT patch, running a single process."
+                  << std::endl;
+#endif
+    }
+
+    return run_server(env_file, config_result, -1, -1);
+}
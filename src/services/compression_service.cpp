@@ -0,0 +1,282 @@
+/**
+ * SPDX-FileComment: Compression Service Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file compression_service.cpp
+ * @brief Implementation of CompressionService.
+ * @version 0.1.4
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/compression_service.hpp"
+#include "utils/app_config.hpp"
+#include "utils/http_cache.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/trace.hpp"
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+#ifdef RZ_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <format>
+
+namespace rz::services {
+
+namespace {
+
+SeriesId savedSeries() {
+    static const auto series = MetricsService::getInstance().registerCounter(
+        "rz_compression_saved_bytes_total", "Response bytes saved by compression.");
+    return series;
+}
+
+std::string_view negotiate(std::string_view accept_encoding) {
+    if (accept_encoding.empty()) return {};
+    for (auto coding : CompressionService::codings()) {
+        if (rz::utils::HttpCache::acceptsEncoding(accept_encoding, coding)) return coding;
+    }
+    return {};
+}
+
+// "\"abc\"" + "gzip" -> "\"abc-gzip\"" (also for weak tags)
+std::string variantEtag(std::string_view etag, std::string_view coding) {
+    if (etag.size() < 2 || !etag.ends_with('"')) return std::string(etag);
+    return std::format("{}-{}\"", etag.substr(0, etag.size() - 1), coding);
+}
+
+} // namespace
+
+CompressionService& CompressionService::getInstance() {
+    static CompressionService instance;
+    return instance;
+}
+
+CompressionService::CompressionService()
+    : m_memory(rz::utils::MemoryAccounting::getInstance().account(
+          "compression_cache", [this](std::size_t target) { return shrink(target); })) {
+    MetricsService::getInstance().addCollector([this](std::string& out) {
+        std::size_t bytes;
+        {
+            std::lock_guard lock(m_mutex);
+            bytes = m_cacheBytes;
+        }
+        out += "# HELP rz_compression_cache_bytes Compressed bodies held in the compression cache.\n"
+               "# TYPE rz_compression_cache_bytes gauge\n";
+        out += std::format("rz_compression_cache_bytes {}\n", bytes);
+    });
+}
+
+const std::vector<std::string_view>& CompressionService::codings() {
+#ifdef RZ_HAVE_ZSTD
+    static const std::vector<std::string_view> supported{"zstd", "gzip", "deflate"};
+#else
+    static const std::vector<std::string_view> supported{"gzip", "deflate"};
+#endif
+    return supported;
+}
+
+void CompressionService::configure() {
+    auto& config = rz::utils::AppConfig::getInstance();
+    auto& metrics = MetricsService::getInstance();
+
+    auto enabled = config.getBool("COMPRESSION_ENABLED", true);
+    if (!enabled) spdlog::warn("{}", enabled.error());
+    m_enabled = enabled.value_or(true);
+    m_minBytes = static_cast<std::size_t>(std::max(0, config.getInt("COMPRESSION_MIN_BYTES", 1024)));
+    m_maxCacheBytes = static_cast<std::size_t>(std::max(0, config.getInt("COMPRESSION_CACHE_MAX_BYTES", 16777216)));
+
+    m_levels.clear();
+    std::string levels = config.getString(
+        "COMPRESSION_LEVELS", "text/=6;application/json=6;application/javascript=6;application/xml=6;image/svg+xml=9");
+    for (std::string_view entry : rz::utils::StringUtils::splitList(levels)) {
+        auto key_value = rz::utils::StringUtils::splitKeyValue(entry);
+        int level = 0;
+        std::string_view number = key_value ? key_value->second : std::string_view{};
+        if (!key_value || std::from_chars(number.data(), number.data() + number.size(), level).ec != std::errc{}) {
+            spdlog::warn("COMPRESSION_LEVELS: invalid entry '{}'", entry);
+            continue;
+        }
+        m_levels.emplace_back(std::string(key_value->first), level);
+    }
+    // Longest prefix wins, e.g. "text/html" before "text/"
+    std::sort(m_levels.begin(), m_levels.end(),
+              [](const auto& a, const auto& b) { return a.first.size() > b.first.size(); });
+
+    m_codingSeries.clear();
+    for (auto coding : codings()) {
+        m_codingSeries.push_back(metrics.registerCounter(
+            "rz_compression_responses_total", "Responses sent with a content coding by the compression middleware.",
+            std::format("coding=\"{}\"", coding)));
+    }
+    m_hitSeries = metrics.registerCounter("rz_compression_cache_requests_total",
+                                          "Lookups of compressed bodies by ETag.", "result=\"hit\"");
+    m_missSeries = metrics.registerCounter("rz_compression_cache_requests_total",
+                                           "Lookups of compressed bodies by ETag.", "result=\"miss\"");
+
+    if (m_enabled) {
+        std::string supported;
+        for (auto coding : codings()) supported += (supported.empty() ? "" : ", ") + std::string(coding);
+        spdlog::info("Compression: {} for bodies >= {} bytes, {} content types, cache {} KiB", supported, m_minBytes,
+                     m_levels.size(), m_maxCacheBytes / 1024);
+    }
+}
+
+int CompressionService::levelFor(std::string_view content_type) const {
+    content_type = rz::utils::StringUtils::trim(content_type.substr(0, content_type.find(';')));
+    for (const auto& [prefix, level] : m_levels) {
+        if (content_type.starts_with(prefix)) return level;
+    }
+    return 0; // Not listed: not compressed (images, archives, ...)
+}
+
+std::expected<std::string, std::string> CompressionService::compress(std::string_view data, std::string_view coding,
+                                                                     int level) {
+#ifdef RZ_HAVE_ZSTD
+    if (coding == "zstd") {
+        std::string out(ZSTD_compressBound(data.size()), '\0');
+        level = std::clamp(level, 1, ZSTD_maxCLevel());
+        std::size_t written = ZSTD_compress(out.data(), out.size(), data.data(), data.size(), level);
+        if (ZSTD_isError(written)) return std::unexpected(std::string(ZSTD_getErrorName(written)));
+        out.resize(written);
+        return out;
+    }
+#endif
+    if (coding != "gzip" && coding != "deflate") {
+        return std::unexpected(std::format("unsupported content coding '{}'", coding));
+    }
+    if (data.size() > UINT_MAX) return std::unexpected("body too large for zlib");
+
+    // windowBits 15 + 16 writes a gzip wrapper, plain 15 the zlib format HTTP calls "deflate"
+    z_stream zs{};
+    if (deflateInit2(&zs, std::clamp(level, 1, 9), Z_DEFLATED, coding == "gzip" ? 31 : 15, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return std::unexpected("deflateInit2 failed");
+    }
+    std::string out(deflateBound(&zs, static_cast<uLong>(data.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(out.data());
+    zs.avail_out = static_cast<uInt>(out.size());
+    const int rc = deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    if (rc != Z_STREAM_END) return std::unexpected(std::format("deflate failed ({})", rc));
+    return out;
+}
+
+void CompressionService::apply(const crow::request& req, crow::response& res) {
+    if (!m_enabled || req.method == crow::HTTPMethod::HEAD) return;
+
+    const std::string_view coding = negotiate(req.get_header_value("Accept-Encoding"));
+    const std::string etag = res.get_header_value("ETag");
+
+    if (res.code == 304) {
+        // The client revalidated the compressed variant; answer with the ETag it holds
+        if (!coding.empty() && !etag.empty()) {
+            std::string variant = variantEtag(etag, coding);
+            if (req.get_header_value("If-None-Match").find(variant) != std::string::npos) {
+                res.set_header("ETag", variant);
+            }
+        }
+        return;
+    }
+
+    if (res.code != 200 || res.body.size() < m_minBytes || !res.get_header_value("Content-Encoding").empty() ||
+        res.get_header_value("Cache-Control").find("no-transform") != std::string::npos) {
+        return;
+    }
+    const int level = levelFor(res.get_header_value("Content-Type"));
+    if (level <= 0) return;
+
+    // Caches must keep the variants apart, even for clients that get the identity body
+    const std::string vary = res.get_header_value("Vary");
+    if (vary.empty()) {
+        res.set_header("Vary", "Accept-Encoding");
+    } else if (vary.find("Accept-Encoding") == std::string::npos) {
+        res.set_header("Vary", vary + ", Accept-Encoding");
+    }
+    if (coding.empty()) return;
+
+    rz::utils::TraceSpan span("compression.apply");
+    Body compressed;
+    std::string key;
+    if (!etag.empty() && !etag.starts_with("W/")) {
+        // A strong ETag only identifies the bytes of one resource; static-file tags are
+        // size and mtime, which files unpacked from an archive can share
+        key = std::format("{} {} {}", req.url, etag, coding);
+        compressed = lookup(key);
+    }
+    if (!compressed) {
+        auto result = compress(res.body, coding, level);
+        if (!result) {
+            spdlog::warn("Compression ({}) failed: {}", coding, result.error());
+            return;
+        }
+        compressed = std::make_shared<const std::string>(std::move(*result));
+        if (!key.empty()) store(key, compressed);
+    }
+    if (compressed->size() >= res.body.size()) return; // Incompressible
+
+    auto& metrics = MetricsService::getInstance();
+    const auto& supported = codings();
+    metrics.increment(m_codingSeries[std::find(supported.begin(), supported.end(), coding) - supported.begin()]);
+    metrics.increment(savedSeries(), res.body.size() - compressed->size());
+
+    res.body = *compressed;
+    res.set_header("Content-Encoding", std::string(coding));
+    if (!etag.empty()) {
+        res.set_header("ETag", variantEtag(etag, coding));
+    }
+}
+
+CompressionService::Body CompressionService::lookup(const std::string& key) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        MetricsService::getInstance().increment(m_missSeries);
+        return nullptr;
+    }
+    MetricsService::getInstance().increment(m_hitSeries);
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->body;
+}
+
+void CompressionService::store(const std::string& key, Body body) {
+    if (body->size() > m_maxCacheBytes / 4) return; // One body must not flush the cache
+
+    std::lock_guard lock(m_mutex);
+    if (m_index.contains(key)) return; // Compressed concurrently by another request
+    m_lru.push_front(Entry{key, body});
+    m_index.emplace(key, m_lru.begin());
+    m_cacheBytes += body->size();
+    evictLocked(m_maxCacheBytes);
+}
+
+void CompressionService::evictLocked(std::size_t target) {
+    while (m_cacheBytes > target && !m_lru.empty()) {
+        m_cacheBytes -= m_lru.back().body->size();
+        m_index.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+    m_memory.set(m_cacheBytes);
+}
+
+std::size_t CompressionService::shrink(std::size_t target) {
+    std::lock_guard lock(m_mutex);
+    std::size_t before = m_cacheBytes;
+    evictLocked(target);
+    return before - m_cacheBytes;
+}
+
+} // namespace rz::services
@@ -7,8 +7,8 @@
  *
  * @file database_service.cpp
  * @brief Implementation of DatabaseService.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.7
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -17,23 +17,135 @@
  */
 
 #include "services/database_service.hpp"
+#include "services/db_shard.hpp"
+#include "services/metrics_service.hpp"
 #include "utils/app_config.hpp"
+#include "utils/memory_accounting.hpp"
+#include "utils/trace.hpp"
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
-#include <print>
+#include <format>
+#include <future>
+#include <optional>
 #include <spdlog/spdlog.h>
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace rz::services {
 
+namespace {
+
+SeriesId queryLatencySeries(const char *op) {
+  return MetricsService::getInstance().registerHistogram(
+      "rz_db_query_duration_seconds", "Latency of SQLite operations.",
+      std::string("op=\"") + op + "\"");
+}
+
+// DB_SHARDS values whose files exist next to @p base (1 = @p base itself)
+std::vector<std::size_t> layoutsOnDisk(const std::string &base) {
+  std::vector<std::size_t> counts;
+  std::error_code ec;
+  std::filesystem::path path(base);
+  if (std::filesystem::exists(path, ec))
+    counts.push_back(1);
+
+  const std::string prefix = path.stem().string() + ".";
+  const std::string ext = path.extension().string();
+  std::filesystem::path dir =
+      path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+  for (const auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+    // "<stem>.<index>-of-<count><ext>"
+    std::string name = entry.path().filename().string();
+    if (!name.starts_with(prefix) || !name.ends_with(ext) ||
+        name.size() <= prefix.size() + ext.size())
+      continue;
+    std::string_view middle(name);
+    middle = middle.substr(prefix.size(),
+                           middle.size() - prefix.size() - ext.size());
+    auto of = middle.find("-of-");
+    std::size_t count = 0;
+    if (of == std::string_view::npos ||
+        std::from_chars(middle.data() + of + 4, middle.data() + middle.size(),
+                        count)
+                .ptr != middle.data() + middle.size() ||
+        count < 2)
+      continue;
+    if (std::find(counts.begin(), counts.end(), count) == counts.end())
+      counts.push_back(count);
+  }
+  return counts;
+}
+
+// Write lock on byte @p stripe of the e-mail lock file, released on scope exit.
+// POSIX record locks belong to the process, so they only exclude other
+// processes; the threads of this one are ordered by the stripe's mutex.
+class StripeLock {
+public:
+  StripeLock(int fd, std::size_t stripe) : m_fd(fd), m_stripe(stripe) {
+    m_locked = m_fd < 0 || set(F_WRLCK, F_SETLKW);
+  }
+  ~StripeLock() {
+    if (m_fd >= 0 && m_locked)
+      set(F_UNLCK, F_SETLK);
+  }
+  StripeLock(const StripeLock &) = delete;
+  StripeLock &operator=(const StripeLock &) = delete;
+
+  [[nodiscard]] bool locked() const { return m_locked; }
+
+private:
+  bool set(short type, int cmd) {
+    struct flock lock {};
+    lock.l_type = type;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = static_cast<off_t>(m_stripe);
+    lock.l_len = 1;
+    while (::fcntl(m_fd, cmd, &lock) != 0) {
+      if (errno != EINTR)
+        return false;
+    }
+    return true;
+  }
+
+  int m_fd;
+  std::size_t m_stripe;
+  bool m_locked = false;
+};
+
+} // namespace
+
 DatabaseService &DatabaseService::getInstance() {
   static DatabaseService instance;
   return instance;
 }
 
 DatabaseService::~DatabaseService() {
-  if (m_db) {
-    sqlite3_close(m_db);
-    m_db = nullptr;
+  if (m_emailLockFd >= 0)
+    ::close(m_emailLockFd);
+}
+
+std::size_t DatabaseService::shardFor(std::string_view uuid,
+                                      std::size_t count) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : uuid) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
   }
+  return count <= 1 ? 0 : static_cast<std::size_t>(hash % count);
+}
+
+std::string DatabaseService::shardPath(const std::string &base,
+                                       std::size_t index, std::size_t count) {
+  if (count <= 1)
+    return base;
+  std::filesystem::path path(base);
+  std::string file = std::format("{}.{}-of-{}{}", path.stem().string(), index,
+                                 count, path.extension().string());
+  return (path.parent_path() / file).string();
 }
 
 std::expected<void, std::string> DatabaseService::init() {
@@ -45,155 +157,239 @@ std::expected<void, std::string> DatabaseService::init() {
   std::string db_path =
       config.getString("DB_DIR", "./data/db/cppappserver.sqlite");
 
-  // Ensure directory exists
-  std::filesystem::path path(db_path);
-  if (path.has_parent_path() && !std::filesystem::exists(path.parent_path())) {
-    std::filesystem::create_directories(path.parent_path());
-  }
-
-  int rc = sqlite3_open(db_path.c_str(), &m_db);
-  if (rc) {
-    std::string err =
-        "Can't open database: " + std::string(sqlite3_errmsg(m_db));
-    spdlog::error(err);
-    return std::unexpected(err);
-  }
-
-  // Create Tables
-  const char *sql_users = "CREATE TABLE IF NOT EXISTS users ("
-                          "uuid TEXT PRIMARY KEY,"
-                          "name TEXT NOT NULL,"
-                          "email TEXT NOT NULL UNIQUE"
-                          ");";
-
-  const char *sql_config = "CREATE TABLE IF NOT EXISTS config_notification ("
-                           "user_uuid TEXT PRIMARY KEY,"
-                           "email_enabled INTEGER DEFAULT 1,"
-                           "html_email INTEGER DEFAULT 1,"
-                           "push_enabled INTEGER DEFAULT 0,"
-                           "language TEXT DEFAULT 'en',"
-                           "FOREIGN KEY(user_uuid) REFERENCES users(uuid)"
-                           ");";
-
-  if (auto res = executeQuery(sql_users); !res)
-    return res;
-  if (auto res = executeQuery(sql_config); !res)
-    return res;
+  DbShard::Options options;
+  options.count =
+      static_cast<std::size_t>(std::max(1, config.getInt("DB_SHARDS", 1)));
+  options.readers =
+      static_cast<std::size_t>(std::max(0, config.getInt("DB_READERS", 2)));
+  // Wait for locks held by other connections (e.g. other prefork workers)
+  options.busy_timeout_ms = config.getInt("DB_BUSY_TIMEOUT_MS", 5000);
+
+  // A new layout next to the files of another one would start without users
+  bool fresh = true;
+  for (std::size_t i = 0; i < options.count && fresh; ++i) {
+    std::error_code ec;
+    fresh = !std::filesystem::exists(shardPath(db_path, i, options.count), ec);
+  }
+  if (fresh) {
+    for (std::size_t existing : layoutsOnDisk(db_path)) {
+      if (existing == options.count)
+        continue;
+      std::string err = std::format(
+          "{} holds the users of DB_SHARDS={}, but DB_SHARDS={}. Run "
+          "db_reshard --db {} --from {} --to {} first, or set DB_SHARDS={}",
+          shardPath(db_path, 0, existing), existing, options.count, db_path,
+          existing, options.count, existing);
+      spdlog::error(err);
+      return std::unexpected(err);
+    }
+  }
+
+  // Shared by all processes on this DB_DIR (prefork workers, other instances)
+  int email_lock_fd = -1;
+  if (options.count > 1) {
+    std::filesystem::path lock_path(db_path);
+    lock_path.replace_extension(".email-lock");
+    email_lock_fd =
+        ::open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (email_lock_fd < 0) {
+      std::string err = std::format("Cannot open {}: {}", lock_path.string(),
+                                    std::strerror(errno));
+      spdlog::error(err);
+      return std::unexpected(err);
+    }
+  }
+
+  std::vector<std::unique_ptr<DbShard>> shards;
+  std::vector<SeriesId> write_series;
+  for (std::size_t i = 0; i < options.count; ++i) {
+    options.index = i;
+    auto shard = DbShard::open(shardPath(db_path, i, options.count), options);
+    if (!shard) {
+      spdlog::error(shard.error());
+      if (email_lock_fd >= 0)
+        ::close(email_lock_fd);
+      return std::unexpected(shard.error());
+    }
+    shards.push_back(std::move(*shard));
+    write_series.push_back(MetricsService::getInstance().registerCounter(
+        "rz_db_shard_writes_total", "Write transactions committed per shard.",
+        std::format("shard=\"{}\"", i)));
+  }
+  m_shards = std::move(shards);
+  m_writeSeries = std::move(write_series);
+  m_emailLockFd = email_lock_fd;
+
+  // SQLite's own allocator statistics cover the page cache, statements and schema
+  auto &memory = rz::utils::MemoryAccounting::getInstance();
+  std::call_once(m_memoryProbeOnce, [this, &memory] {
+    memory.addProbe(
+        "sqlite",
+        [] {
+          sqlite3_int64 current = 0, highwater = 0;
+          sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &current, &highwater, 0);
+          return rz::utils::MemoryAccounting::Usage{
+              static_cast<std::size_t>(current),
+              static_cast<std::size_t>(highwater)};
+        },
+        [this](std::size_t) { return releaseMemory(); });
+  });
+  if (auto limit = memory.limit("sqlite"); limit > 0) {
+    // SQLite recycles its page cache itself to stay below the limit
+    sqlite3_soft_heap_limit64(static_cast<sqlite3_int64>(limit));
+  }
 
   m_initialized = true;
-  spdlog::info("Database initialized at {}", db_path);
+  if (options.count == 1) {
+    spdlog::info("Database initialized at {} ({} readers)", db_path,
+                 options.readers);
+  } else {
+    spdlog::info("Database initialized: {} shards of {} ({} readers each)",
+                 options.count, db_path, options.readers);
+  }
   return {};
 }
 
-std::expected<void, std::string>
-DatabaseService::executeQuery(const std::string &query) {
-  char *zErrMsg = 0;
-  int rc = sqlite3_exec(m_db, query.c_str(), 0, 0, &zErrMsg);
-  if (rc != SQLITE_OK) {
-    std::string err = "SQL error: " + std::string(zErrMsg);
-    sqlite3_free(zErrMsg);
-    spdlog::error(err);
-    return std::unexpected(err);
-  }
-  return {};
+DbShard *DatabaseService::shard(std::string_view uuid) {
+  if (m_shards.empty())
+    return nullptr;
+  return m_shards[shardFor(uuid, m_shards.size())].get();
 }
 
 std::expected<User, std::string>
 DatabaseService::getUser(const std::string &uuid) {
-  std::string sql = "SELECT uuid, name, email FROM users WHERE uuid = ?;";
-  sqlite3_stmt *stmt;
+  static const SeriesId series = queryLatencySeries("get_user");
+  MetricsTimer timer(series);
+  rz::utils::TraceSpan span("db.get_user");
 
-  if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, 0) != SQLITE_OK) {
-    return std::unexpected(sqlite3_errmsg(m_db));
+  auto *db = shard(uuid);
+  if (!db)
+    return std::unexpected("Database not initialized");
+  return db->getUser(uuid);
+}
+
+std::expected<std::vector<User>, std::string>
+DatabaseService::getUsers(const std::vector<std::string> &uuids) {
+  static const SeriesId series = queryLatencySeries("get_users");
+  MetricsTimer timer(series);
+  rz::utils::TraceSpan span("db.get_users");
+
+  if (m_shards.empty())
+    return std::unexpected("Database not initialized");
+
+  // Positions of the requested UUIDs per shard
+  std::vector<std::vector<std::size_t>> groups(m_shards.size());
+  for (std::size_t i = 0; i < uuids.size(); ++i) {
+    groups[shardFor(uuids[i], m_shards.size())].push_back(i);
   }
 
-  sqlite3_bind_text(stmt, 1, uuid.c_str(), -1, SQLITE_STATIC);
+  std::vector<std::optional<User>> found(uuids.size());
+  auto lookup = [&](std::size_t shard_index) -> std::expected<void, std::string> {
+    for (std::size_t i : groups[shard_index]) {
+      auto user = m_shards[shard_index]->findUser(uuids[i]);
+      if (!user)
+        return std::unexpected(user.error());
+      found[i] = std::move(*user);
+    }
+    return {};
+  };
 
-  User user;
-  int rc = sqlite3_step(stmt);
-  if (rc == SQLITE_ROW) {
-    user.uuid = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-    user.name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
-    user.email = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
-    sqlite3_finalize(stmt);
-    return user;
+  // Every shard involved but the first runs on its own thread
+  std::vector<std::future<std::expected<void, std::string>>> pending;
+  std::optional<std::size_t> local;
+  for (std::size_t s = 0; s < groups.size(); ++s) {
+    if (groups[s].empty())
+      continue;
+    if (!local) {
+      local = s;
+    } else {
+      pending.push_back(std::async(std::launch::async, lookup, s));
+    }
+  }
+  std::expected<void, std::string> result;
+  if (local)
+    result = lookup(*local);
+  for (auto &task : pending) {
+    if (auto res = task.get(); !res && result)
+      result = res;
   }
+  if (!result)
+    return std::unexpected(result.error());
 
-  sqlite3_finalize(stmt);
-  return std::unexpected("User not found");
+  std::vector<User> users;
+  users.reserve(uuids.size());
+  for (auto &user : found) {
+    if (user)
+      users.push_back(std::move(*user));
+  }
+  return users;
 }
 
 std::expected<NotificationConfig, std::string>
 DatabaseService::getNotificationConfig(const std::string &user_uuid) {
-  std::string sql = "SELECT email_enabled, html_email, push_enabled, language "
-                    "FROM config_notification WHERE user_uuid = ?;";
-  sqlite3_stmt *stmt;
+  static const SeriesId series = queryLatencySeries("get_notification_config");
+  MetricsTimer timer(series);
+  rz::utils::TraceSpan span("db.get_notification_config");
 
-  if (sqlite3_prepare_v2(m_db, sql.c_str(), -1, &stmt, 0) != SQLITE_OK) {
-    return std::unexpected(sqlite3_errmsg(m_db));
-  }
+  auto *db = shard(user_uuid);
+  if (!db)
+    return std::unexpected("Database not initialized");
+  return db->getNotificationConfig(user_uuid);
+}
 
-  sqlite3_bind_text(stmt, 1, user_uuid.c_str(), -1, SQLITE_STATIC);
+std::expected<void, std::string>
+DatabaseService::createOrUpdateUser(const User &user,
+                                    const NotificationConfig &config) {
+  static const SeriesId series = queryLatencySeries("create_or_update_user");
+  MetricsTimer timer(series);
+  rz::utils::TraceSpan span("db.create_or_update_user");
 
-  NotificationConfig conf;
-  conf.user_uuid = user_uuid;
+  if (m_shards.empty())
+    return std::unexpected("Database not initialized");
 
-  int rc = sqlite3_step(stmt);
-  if (rc == SQLITE_ROW) {
-    conf.email_enabled = sqlite3_column_int(stmt, 0) != 0;
-    conf.html_email = sqlite3_column_int(stmt, 1) != 0;
-    conf.push_enabled = sqlite3_column_int(stmt, 2) != 0;
-    const char *lang =
-        reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-    conf.language = lang ? lang : "en";
-    sqlite3_finalize(stmt);
-    return conf;
+  // Each shard only enforces the UNIQUE e-mail for its own users, so the
+  // check and the write hold the address's stripe in this process and, through
+  // the lock file, against every other process
+  const std::size_t stripe = shardFor(user.email, m_emailLocks.size());
+  std::lock_guard<std::mutex> claim(m_emailLocks[stripe]);
+  StripeLock cross_process(m_emailLockFd, stripe);
+  if (!cross_process.locked())
+    return std::unexpected(
+        std::format("Cannot lock the e-mail address: {}", std::strerror(errno)));
+  for (auto &shard : m_shards) {
+    auto holder = shard->findUserByEmail(user.email);
+    if (!holder)
+      return std::unexpected(holder.error());
+    if (*holder && (*holder)->uuid != user.uuid)
+      return std::unexpected(
+          std::format("E-mail address already in use by user {}",
+                      (*holder)->uuid));
   }
 
-  sqlite3_finalize(stmt);
-  // Default config if not found
-  return NotificationConfig{user_uuid, true, true, false, "en"};
+  std::size_t index = shardFor(user.uuid, m_shards.size());
+  auto res = m_shards[index]->upsert({{user, config}});
+  if (res)
+    MetricsService::getInstance().increment(m_writeSeries[index]);
+  return res;
 }
 
-std::expected<void, std::string>
-DatabaseService::createOrUpdateUser(const User &user,
-                                    const NotificationConfig &config) {
-  // Transaction
-  executeQuery("BEGIN TRANSACTION;");
-
-  std::string sql_user =
-      "INSERT OR REPLACE INTO users (uuid, name, email) VALUES (?, ?, ?);";
-  sqlite3_stmt *stmt1;
-  sqlite3_prepare_v2(m_db, sql_user.c_str(), -1, &stmt1, 0);
-  sqlite3_bind_text(stmt1, 1, user.uuid.c_str(), -1, SQLITE_STATIC);
-  sqlite3_bind_text(stmt1, 2, user.name.c_str(), -1, SQLITE_STATIC);
-  sqlite3_bind_text(stmt1, 3, user.email.c_str(), -1, SQLITE_STATIC);
-  if (sqlite3_step(stmt1) != SQLITE_DONE) {
-    sqlite3_finalize(stmt1);
-    executeQuery("ROLLBACK;");
-    return std::unexpected("Failed to upsert user");
-  }
-  sqlite3_finalize(stmt1);
-
-  std::string sql_conf =
-      "INSERT OR REPLACE INTO config_notification (user_uuid, email_enabled, "
-      "html_email, push_enabled, language) VALUES (?, ?, ?, ?, ?);";
-  sqlite3_stmt *stmt2;
-  sqlite3_prepare_v2(m_db, sql_conf.c_str(), -1, &stmt2, 0);
-  sqlite3_bind_text(stmt2, 1, user.uuid.c_str(), -1, SQLITE_STATIC);
-  sqlite3_bind_int(stmt2, 2, config.email_enabled ? 1 : 0);
-  sqlite3_bind_int(stmt2, 3, config.html_email ? 1 : 0);
-  sqlite3_bind_int(stmt2, 4, config.push_enabled ? 1 : 0);
-  sqlite3_bind_text(stmt2, 5, config.language.c_str(), -1, SQLITE_STATIC);
-  if (sqlite3_step(stmt2) != SQLITE_DONE) {
-    sqlite3_finalize(stmt2);
-    executeQuery("ROLLBACK;");
-    return std::unexpected("Failed to upsert config");
-  }
-  sqlite3_finalize(stmt2);
-
-  executeQuery("COMMIT;");
+std::expected<void, std::string> DatabaseService::ping() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_initialized || m_shards.empty())
+    return std::unexpected("Database not initialized");
+
+  for (auto &shard : m_shards) {
+    if (auto res = shard->ping(); !res)
+      return res;
+  }
   return {};
 }
 
+std::size_t DatabaseService::releaseMemory() {
+  std::size_t released = 0;
+  for (auto &shard : m_shards)
+    released += shard->releaseMemory();
+  return released;
+}
+
 } // namespace rz::services
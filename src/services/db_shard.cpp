@@ -0,0 +1,344 @@
+/**
+ * SPDX-FileComment: Database Shard Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file db_shard.cpp
+ * @brief Implementation of DbShard.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/db_shard.hpp"
+#include <filesystem>
+#include <format>
+
+namespace rz::services {
+
+namespace {
+
+/**
+ * @brief Finalizes the statement when it goes out of scope.
+ */
+struct Statement {
+    sqlite3_stmt* stmt = nullptr;
+    ~Statement() { sqlite3_finalize(stmt); }
+};
+
+std::expected<void, std::string> exec(sqlite3* db, const char* sql) {
+    char* error = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+        std::string message = std::format("SQL error: {}", error ? error : sqlite3_errmsg(db));
+        sqlite3_free(error);
+        return std::unexpected(message);
+    }
+    return {};
+}
+
+std::string columnText(sqlite3_stmt* stmt, int column) {
+    const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+    return text ? text : "";
+}
+
+} // namespace
+
+DbShard::DbShard(std::string path, const Options& options) : m_path(std::move(path)), m_options(options) {}
+
+DbShard::~DbShard() {
+    for (auto& reader : m_readers) sqlite3_close(reader->db);
+    sqlite3_close(m_writer.db);
+}
+
+std::expected<std::unique_ptr<DbShard>, std::string> DbShard::open(const std::string& path, const Options& options) {
+    std::unique_ptr<DbShard> shard(new DbShard(path, options));
+
+    if (options.read_only) {
+        if (auto res = shard->openConnection(shard->m_writer, SQLITE_OPEN_READONLY); !res) {
+            return std::unexpected(res.error());
+        }
+    } else {
+        std::filesystem::path file(path);
+        if (file.has_parent_path()) std::filesystem::create_directories(file.parent_path());
+        if (auto res = shard->openConnection(shard->m_writer, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE); !res) {
+            return std::unexpected(res.error());
+        }
+        // WAL lets the readers run while the writer commits; the mode is stored in the file
+        if (auto res = exec(shard->m_writer.db, "PRAGMA journal_mode=WAL;"); !res) return std::unexpected(res.error());
+        if (auto res = shard->createSchema(); !res) return std::unexpected(res.error());
+
+        // Readers are opened after the schema exists
+        for (std::size_t i = 0; i < options.readers; ++i) {
+            auto& reader = shard->m_readers.emplace_back(std::make_unique<Connection>());
+            if (auto res = shard->openConnection(*reader, SQLITE_OPEN_READONLY); !res) {
+                return std::unexpected(res.error());
+            }
+        }
+    }
+
+    // Files written before sharding have no layout record and count as the only shard
+    Statement meta;
+    if (sqlite3_prepare_v2(shard->m_writer.db, "SELECT shard, shards FROM shard_meta WHERE id = 0;", -1, &meta.stmt,
+                           nullptr) == SQLITE_OK &&
+        sqlite3_step(meta.stmt) == SQLITE_ROW) {
+        auto index = static_cast<std::size_t>(sqlite3_column_int64(meta.stmt, 0));
+        auto count = static_cast<std::size_t>(sqlite3_column_int64(meta.stmt, 1));
+        if (index != options.index || count != options.count) {
+            return std::unexpected(std::format("{} is shard {} of {}, expected shard {} of {}", path, index, count,
+                                               options.index, options.count));
+        }
+    } else if (options.count != 1) {
+        return std::unexpected(std::format("{} has no shard layout record", path));
+    }
+    return shard;
+}
+
+std::expected<void, std::string> DbShard::openConnection(Connection& conn, int flags) {
+    if (sqlite3_open_v2(m_path.c_str(), &conn.db, flags | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+        return std::unexpected(std::format("Can't open database {}: {}", m_path, sqlite3_errmsg(conn.db)));
+    }
+    sqlite3_busy_timeout(conn.db, m_options.busy_timeout_ms);
+    return {};
+}
+
+std::expected<void, std::string> DbShard::createSchema() {
+    static constexpr const char* schema =
+        "CREATE TABLE IF NOT EXISTS users ("
+        "uuid TEXT PRIMARY KEY,"
+        "name TEXT NOT NULL,"
+        "email TEXT NOT NULL UNIQUE"
+        ");"
+        "CREATE TABLE IF NOT EXISTS config_notification ("
+        "user_uuid TEXT PRIMARY KEY,"
+        "email_enabled INTEGER DEFAULT 1,"
+        "html_email INTEGER DEFAULT 1,"
+        "push_enabled INTEGER DEFAULT 0,"
+        "language TEXT DEFAULT 'en',"
+        "FOREIGN KEY(user_uuid) REFERENCES users(uuid)"
+        ");"
+        "CREATE TABLE IF NOT EXISTS shard_meta ("
+        "id INTEGER PRIMARY KEY CHECK (id = 0),"
+        "shard INTEGER NOT NULL,"
+        "shards INTEGER NOT NULL"
+        ");";
+    if (auto res = exec(m_writer.db, schema); !res) return res;
+
+    Statement insert;
+    if (sqlite3_prepare_v2(m_writer.db, "INSERT OR IGNORE INTO shard_meta (id, shard, shards) VALUES (0, ?, ?);", -1,
+                           &insert.stmt, nullptr) != SQLITE_OK) {
+        return std::unexpected(sqlite3_errmsg(m_writer.db));
+    }
+    sqlite3_bind_int64(insert.stmt, 1, static_cast<sqlite3_int64>(m_options.index));
+    sqlite3_bind_int64(insert.stmt, 2, static_cast<sqlite3_int64>(m_options.count));
+    if (sqlite3_step(insert.stmt) != SQLITE_DONE) return std::unexpected(sqlite3_errmsg(m_writer.db));
+    return {};
+}
+
+std::unique_lock<std::mutex> DbShard::lockReader(sqlite3*& db) {
+    if (m_readers.empty()) {
+        db = m_writer.db;
+        return std::unique_lock(m_writer.mutex);
+    }
+    // Round robin, skipping readers another thread is using
+    std::size_t start = m_nextReader.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < m_readers.size(); ++i) {
+        auto& reader = *m_readers[(start + i) % m_readers.size()];
+        std::unique_lock lock(reader.mutex, std::try_to_lock);
+        if (lock) {
+            db = reader.db;
+            return lock;
+        }
+    }
+    auto& reader = *m_readers[start % m_readers.size()];
+    db = reader.db;
+    return std::unique_lock(reader.mutex);
+}
+
+std::expected<User, std::string> DbShard::getUser(const std::string& uuid) {
+    auto user = findUser(uuid);
+    if (!user) return std::unexpected(user.error());
+    if (!*user) return std::unexpected("User not found");
+    return std::move(**user);
+}
+
+std::expected<std::optional<User>, std::string> DbShard::findUser(const std::string& uuid) {
+    return queryUser("SELECT uuid, name, email FROM users WHERE uuid = ?;", uuid);
+}
+
+std::expected<std::optional<User>, std::string> DbShard::findUserByEmail(const std::string& email) {
+    return queryUser("SELECT uuid, name, email FROM users WHERE email = ?;", email);
+}
+
+std::expected<std::optional<User>, std::string> DbShard::queryUser(const char* sql, const std::string& value) {
+    sqlite3* db;
+    auto lock = lockReader(db);
+
+    Statement query;
+    if (sqlite3_prepare_v2(db, sql, -1, &query.stmt, nullptr) != SQLITE_OK) {
+        return std::unexpected(sqlite3_errmsg(db));
+    }
+    sqlite3_bind_text(query.stmt, 1, value.c_str(), -1, SQLITE_STATIC);
+
+    int rc = sqlite3_step(query.stmt);
+    if (rc == SQLITE_DONE) return std::nullopt;
+    if (rc != SQLITE_ROW) return std::unexpected(sqlite3_errmsg(db));
+    return User{columnText(query.stmt, 0), columnText(query.stmt, 1), columnText(query.stmt, 2)};
+}
+
+std::expected<NotificationConfig, std::string> DbShard::getNotificationConfig(const std::string& user_uuid) {
+    sqlite3* db;
+    auto lock = lockReader(db);
+
+    Statement query;
+    if (sqlite3_prepare_v2(db,
+                           "SELECT email_enabled, html_email, push_enabled, language "
+                           "FROM config_notification WHERE user_uuid = ?;",
+                           -1, &query.stmt, nullptr) != SQLITE_OK) {
+        return std::unexpected(sqlite3_errmsg(db));
+    }
+    sqlite3_bind_text(query.stmt, 1, user_uuid.c_str(), -1, SQLITE_STATIC);
+
+    if (sqlite3_step(query.stmt) != SQLITE_ROW) {
+        // Default config if not found
+        return NotificationConfig{user_uuid, true, true, false, "en"};
+    }
+    std::string language = columnText(query.stmt, 3);
+    return NotificationConfig{user_uuid, sqlite3_column_int(query.stmt, 0) != 0, sqlite3_column_int(query.stmt, 1) != 0,
+                              sqlite3_column_int(query.stmt, 2) != 0, language.empty() ? "en" : language};
+}
+
+std::expected<void, std::string> DbShard::upsert(const std::vector<std::pair<User, NotificationConfig>>& rows) {
+    // Only a UUID conflict updates; OR REPLACE would also delete another user holding the e-mail address
+    return write(rows,
+                 "INSERT INTO users (uuid, name, email) VALUES (?, ?, ?) "
+                 "ON CONFLICT(uuid) DO UPDATE SET name = excluded.name, email = excluded.email;",
+                 "INSERT OR REPLACE INTO config_notification (user_uuid, email_enabled, "
+                 "html_email, push_enabled, language) VALUES (?, ?, ?, ?, ?);");
+}
+
+std::expected<void, std::string> DbShard::insert(const std::vector<std::pair<User, NotificationConfig>>& rows) {
+    return write(rows, "INSERT INTO users (uuid, name, email) VALUES (?, ?, ?);",
+                 "INSERT INTO config_notification (user_uuid, email_enabled, "
+                 "html_email, push_enabled, language) VALUES (?, ?, ?, ?, ?);");
+}
+
+std::expected<void, std::string> DbShard::write(const std::vector<std::pair<User, NotificationConfig>>& rows,
+                                                const char* user_sql, const char* config_sql) {
+    if (m_options.read_only) return std::unexpected(std::format("{} is opened read-only", m_path));
+    std::lock_guard lock(m_writer.mutex);
+    sqlite3* db = m_writer.db;
+
+    // IMMEDIATE takes the write lock up front instead of upgrading (and failing) mid-transaction
+    if (auto res = exec(db, "BEGIN IMMEDIATE;"); !res) return res;
+    auto rollback = [db](std::string error) -> std::expected<void, std::string> {
+        exec(db, "ROLLBACK;");
+        return std::unexpected(std::move(error));
+    };
+
+    Statement user_stmt;
+    Statement config_stmt;
+    if (sqlite3_prepare_v2(db, user_sql, -1, &user_stmt.stmt, nullptr) != SQLITE_OK ||
+        sqlite3_prepare_v2(db, config_sql, -1, &config_stmt.stmt, nullptr) != SQLITE_OK) {
+        return rollback(sqlite3_errmsg(db));
+    }
+
+    for (const auto& [user, config] : rows) {
+        sqlite3_reset(user_stmt.stmt);
+        sqlite3_bind_text(user_stmt.stmt, 1, user.uuid.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(user_stmt.stmt, 2, user.name.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(user_stmt.stmt, 3, user.email.c_str(), -1, SQLITE_STATIC);
+        if (sqlite3_step(user_stmt.stmt) != SQLITE_DONE) {
+            return rollback(std::format("Failed to write user {} <{}>: {}", user.uuid, user.email, sqlite3_errmsg(db)));
+        }
+
+        sqlite3_reset(config_stmt.stmt);
+        sqlite3_bind_text(config_stmt.stmt, 1, user.uuid.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(config_stmt.stmt, 2, config.email_enabled ? 1 : 0);
+        sqlite3_bind_int(config_stmt.stmt, 3, config.html_email ? 1 : 0);
+        sqlite3_bind_int(config_stmt.stmt, 4, config.push_enabled ? 1 : 0);
+        sqlite3_bind_text(config_stmt.stmt, 5, config.language.c_str(), -1, SQLITE_STATIC);
+        if (sqlite3_step(config_stmt.stmt) != SQLITE_DONE) {
+            return rollback(std::format("Failed to write config of {}: {}", user.uuid, sqlite3_errmsg(db)));
+        }
+    }
+
+    if (auto res = exec(db, "COMMIT;"); !res) return rollback(res.error());
+    return {};
+}
+
+std::expected<std::size_t, std::string> DbShard::forEach(
+    const std::function<void(const User&, const NotificationConfig&)>& fn) {
+    sqlite3* db;
+    auto lock = lockReader(db);
+
+    Statement query;
+    if (sqlite3_prepare_v2(db,
+                           "SELECT u.uuid, u.name, u.email, c.email_enabled, c.html_email, c.push_enabled, "
+                           "c.language, c.user_uuid IS NOT NULL FROM users u "
+                           "LEFT JOIN config_notification c ON c.user_uuid = u.uuid;",
+                           -1, &query.stmt, nullptr) != SQLITE_OK) {
+        return std::unexpected(sqlite3_errmsg(db));
+    }
+
+    std::size_t rows = 0;
+    int rc;
+    while ((rc = sqlite3_step(query.stmt)) == SQLITE_ROW) {
+        User user{columnText(query.stmt, 0), columnText(query.stmt, 1), columnText(query.stmt, 2)};
+        NotificationConfig config{user.uuid, true, true, false, "en"};
+        if (sqlite3_column_int(query.stmt, 7) != 0) {
+            std::string language = columnText(query.stmt, 6);
+            config = {user.uuid, sqlite3_column_int(query.stmt, 3) != 0, sqlite3_column_int(query.stmt, 4) != 0,
+                      sqlite3_column_int(query.stmt, 5) != 0, language.empty() ? "en" : language};
+        }
+        fn(user, config);
+        ++rows;
+    }
+    if (rc != SQLITE_DONE) return std::unexpected(sqlite3_errmsg(db));
+    return rows;
+}
+
+std::expected<std::size_t, std::string> DbShard::count() {
+    sqlite3* db;
+    auto lock = lockReader(db);
+
+    Statement query;
+    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM users;", -1, &query.stmt, nullptr) != SQLITE_OK ||
+        sqlite3_step(query.stmt) != SQLITE_ROW) {
+        return std::unexpected(std::format("{}: {}", m_path, sqlite3_errmsg(db)));
+    }
+    return static_cast<std::size_t>(sqlite3_column_int64(query.stmt, 0));
+}
+
+std::expected<void, std::string> DbShard::ping() {
+    sqlite3* db;
+    auto lock = lockReader(db);
+
+    Statement query;
+    if (sqlite3_prepare_v2(db, "SELECT 1;", -1, &query.stmt, nullptr) != SQLITE_OK ||
+        sqlite3_step(query.stmt) != SQLITE_ROW) {
+        return std::unexpected(std::format("{}: {}", m_path, sqlite3_errmsg(db)));
+    }
+    return {};
+}
+
+std::size_t DbShard::releaseMemory() {
+    sqlite3_int64 before = sqlite3_memory_used();
+    {
+        std::lock_guard lock(m_writer.mutex);
+        sqlite3_db_release_memory(m_writer.db);
+    }
+    for (auto& reader : m_readers) {
+        std::lock_guard lock(reader->mutex);
+        sqlite3_db_release_memory(reader->db);
+    }
+    sqlite3_int64 after = sqlite3_memory_used();
+    return before > after ? static_cast<std::size_t>(before - after) : 0;
+}
+
+} // namespace rz::services
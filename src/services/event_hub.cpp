@@ -0,0 +1,223 @@
+/**
+ * SPDX-FileComment: Event Hub Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file event_hub.cpp
+ * @brief Implementation of EventHub.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/event_hub.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/app_config.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+
+namespace rz::services {
+
+namespace {
+
+SeriesId publishedSeries() {
+    static const auto series = MetricsService::getInstance().registerCounter(
+        "rz_sse_events_published_total", "Events published to the SSE ring.");
+    return series;
+}
+
+SeriesId skippedSeries() {
+    static const auto series = MetricsService::getInstance().registerCounter(
+        "rz_sse_events_skipped_total", "Events slow SSE subscribers skipped because they left the ring.");
+    return series;
+}
+
+// crow::response owns its body as a std::string, so every connection gets its own copy of the batch
+void respond(crow::response& res, const std::string& body) {
+    res.code = 200;
+    res.set_header("Content-Type", "text/event-stream");
+    res.set_header("Cache-Control", "no-cache");
+    res.set_header("X-Accel-Buffering", "no");
+    res.body = body;
+    res.end();
+}
+
+} // namespace
+
+/**
+ * @brief A parked stream window. Only touched on its connection's I/O thread,
+ * except for the map entry owned by the hub.
+ */
+struct EventHub::Waiter {
+    explicit Waiter(asio::io_context& io_context) : io(&io_context), timer(io_context) {}
+
+    std::uint64_t id = 0;
+    std::uint64_t cursor = 0; // Next event ID the subscriber wants
+    crow::response* res = nullptr;
+    asio::io_context* io;
+    asio::steady_timer timer;
+    bool done = false;
+};
+
+EventHub& EventHub::getInstance() {
+    static EventHub instance;
+    return instance;
+}
+
+EventHub::EventHub() : m_ring(1024), m_memory(rz::utils::MemoryAccounting::getInstance().account("event_ring")) {
+    MetricsService::getInstance().addCollector([this](std::string& out) {
+        out += "# HELP rz_sse_waiting_subscribers SSE subscribers parked waiting for events.\n"
+               "# TYPE rz_sse_waiting_subscribers gauge\n";
+        out += std::format("rz_sse_waiting_subscribers {}\n", waiting());
+    });
+}
+
+void EventHub::configure() {
+    auto& config = rz::utils::AppConfig::getInstance();
+    std::lock_guard lock(m_mutex);
+    m_ring.assign(static_cast<std::size_t>(std::max(16, config.getInt("EVENT_RING_SIZE", 1024))), nullptr);
+    m_batch.reset();
+    m_memory.set(0);
+    m_window = std::chrono::seconds(std::clamp(config.getInt("EVENT_STREAM_WINDOW_SEC", 25), 1, 300));
+    m_retryMs = std::max(0, config.getInt("EVENT_STREAM_RETRY_MS", 250));
+    m_maxBatch = static_cast<std::size_t>(std::max(1, config.getInt("EVENT_STREAM_MAX_BATCH", 256)));
+    spdlog::info("SSE hub: ring {} events, window {} s, retry {} ms", m_ring.size(), m_window.count(), m_retryMs);
+}
+
+std::uint64_t EventHub::publish(std::string_view type, const nlohmann::json& data) {
+    const std::string payload = data.dump();
+
+    std::uint64_t id;
+    std::unordered_map<std::uint64_t, WaiterPtr> waiters;
+    {
+        std::lock_guard lock(m_mutex);
+        id = ++m_head;
+        auto& slot = m_ring[id % m_ring.size()];
+        if (slot) m_memory.sub(slot->capacity());
+        slot = std::make_shared<const std::string>(std::format("id: {}\nevent: {}\ndata: {}\n\n", id, type, payload));
+        m_memory.add(slot->capacity());
+        // Every parked window is answered with this event
+        waiters.swap(m_waiters);
+    }
+    MetricsService::getInstance().increment(publishedSeries());
+
+    for (auto& [waiter_id, waiter] : waiters) {
+        asio::post(*waiter->io, [this, waiter]() { complete(waiter); });
+    }
+    return id;
+}
+
+void EventHub::subscribe(const crow::request& req, crow::response& res) {
+    std::string last_id = req.get_header_value("Last-Event-ID");
+    if (last_id.empty()) {
+        // EventSource polyfills without custom header support pass it in the query
+        if (const char* param = req.url_params.get("lastEventId")) last_id = param;
+    }
+
+    WaiterPtr waiter;
+    std::uint64_t cursor;
+    {
+        std::lock_guard lock(m_mutex);
+        cursor = m_head + 1;
+        if (!last_id.empty()) {
+            // IDs from a previous process (restart) are clamped to "new events only"
+            std::uint64_t seen = std::strtoull(last_id.c_str(), nullptr, 10);
+            cursor = seen >= m_head ? m_head + 1 : seen + 1;
+        }
+
+        if (cursor > m_head && req.io_context) {
+            // Nothing to send yet: park until the next publish or the end of the window
+            waiter = std::make_shared<Waiter>(*req.io_context);
+            waiter->id = ++m_nextWaiter;
+            waiter->cursor = cursor;
+            waiter->res = &res;
+            m_waiters.emplace(waiter->id, waiter);
+        }
+    }
+
+    if (!waiter) {
+        respond(res, *collect(cursor));
+        return;
+    }
+
+    waiter->timer.expires_after(m_window);
+    waiter->timer.async_wait([this, waiter](const auto& ec) {
+        if (ec) return; // Cancelled by complete()
+        {
+            std::lock_guard lock(m_mutex);
+            m_waiters.erase(waiter->id);
+        }
+        complete(waiter);
+    });
+}
+
+void EventHub::complete(const WaiterPtr& waiter) {
+    // Publish and timeout can both schedule completion; both run on the waiter's thread
+    if (waiter->done) return;
+    waiter->done = true;
+    waiter->timer.cancel();
+    respond(*waiter->res, *collect(waiter->cursor));
+}
+
+EventHub::Batch EventHub::collect(std::uint64_t cursor) {
+    std::vector<std::shared_ptr<const std::string>> frames;
+    std::uint64_t skipped = 0;
+    std::uint64_t last_id;
+    const std::uint64_t first = cursor;
+    {
+        std::lock_guard lock(m_mutex);
+        const std::uint64_t oldest = m_head >= m_ring.size() ? m_head - m_ring.size() + 1 : 1;
+        if (cursor < oldest && cursor <= m_head) {
+            skipped = oldest - cursor;
+            cursor = oldest;
+        }
+        const std::uint64_t last = std::min<std::uint64_t>(m_head, cursor + m_maxBatch - 1);
+        last_id = cursor <= last ? last : m_head;
+        // The windows a publish wakes all start at the same cursor and share one joined body
+        if (m_batch && m_batchFirst == first && m_batchLast == last_id) return m_batch;
+        for (std::uint64_t id = cursor; id <= last; ++id) {
+            frames.push_back(m_ring[id % m_ring.size()]);
+        }
+    }
+
+    std::size_t size = 32;
+    for (const auto& frame : frames) size += frame->size();
+    std::string body;
+    body.reserve(size + (skipped ? 64 : 0));
+    body += std::format("retry: {}\n", m_retryMs);
+
+    if (skipped > 0) {
+        // The subscriber was too slow for the ring; it resumes at the oldest retained event
+        MetricsService::getInstance().increment(skippedSeries(), skipped);
+        body += std::format("event: overflow\ndata: {{\"skipped\":{}}}\n\n", skipped);
+    }
+    for (const auto& frame : frames) {
+        body += *frame;
+    }
+    if (frames.empty()) {
+        // An ID without data moves the client's Last-Event-ID without dispatching an event
+        body += std::format("id: {}\n\n", last_id);
+    }
+
+    auto batch = std::make_shared<const std::string>(std::move(body));
+    std::lock_guard lock(m_mutex);
+    m_batch = batch;
+    m_batchFirst = first;
+    m_batchLast = last_id;
+    return batch;
+}
+
+std::size_t EventHub::waiting() const {
+    std::lock_guard lock(m_mutex);
+    return m_waiters.size();
+}
+
+} // namespace rz::services
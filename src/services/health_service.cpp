@@ -0,0 +1,244 @@
+/**
+ * SPDX-FileComment: Health Service Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file health_service.cpp
+ * @brief Implementation of HealthService.
+ * @version 0.1.3
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/health_service.hpp"
+#include "services/database_service.hpp"
+#include "utils/app_config.hpp"
+#include "utils/json_writer.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <ctime>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace rz::services {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string formatLocalTime(std::chrono::system_clock::time_point tp) {
+    std::time_t t = std::chrono::system_clock::to_time_t(tp);
+    std::tm tm{};
+    localtime_r(&t, &tm); // thread-safe variant of std::localtime
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+    return buf;
+}
+
+std::chrono::microseconds elapsedSince(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+}
+
+// Non-blocking TCP connect with timeout. Returns an empty string on success.
+std::string tcpConnect(const std::string& host, int port, std::chrono::milliseconds timeout) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    std::string service = std::to_string(port);
+    if (int rc = getaddrinfo(host.c_str(), service.c_str(), &hints, &result); rc != 0) {
+        return std::string("resolve failed: ") + gai_strerror(rc);
+    }
+
+    std::string error = "no address";
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+        int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            error = std::strerror(errno);
+            continue;
+        }
+
+        int rc = ::connect(fd, ai->ai_addr, ai->ai_addrlen);
+        if (rc != 0 && errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            rc = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+            if (rc == 0) {
+                error = "connect timeout";
+                rc = -1;
+            } else if (rc > 0) {
+                int so_error = 0;
+                socklen_t len = sizeof(so_error);
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len);
+                rc = so_error == 0 ? 0 : -1;
+                if (so_error != 0) error = std::strerror(so_error);
+            } else {
+                error = std::strerror(errno);
+            }
+        } else if (rc != 0) {
+            error = std::strerror(errno);
+        }
+        ::close(fd);
+
+        if (rc == 0) {
+            freeaddrinfo(result);
+            return {};
+        }
+    }
+    freeaddrinfo(result);
+    return error;
+}
+
+std::shared_ptr<const HealthSnapshot> makeSnapshot(std::string status,
+                                                   std::vector<HealthCheckResult> checks) {
+    auto snap = std::make_shared<HealthSnapshot>();
+    snap->status = std::move(status);
+    snap->http_code = (snap->status == "ok" || snap->status == "degraded") ? 200 : 503;
+    snap->timestamp = formatLocalTime(std::chrono::system_clock::now());
+    snap->checks = std::move(checks);
+
+    rz::utils::JsonWriter json(512);
+    json.beginObject()
+        .field<"status">(snap->status)
+        .field<"timestamp">(snap->timestamp)
+        .key<"checks">()
+        .beginObject();
+    for (const auto& check : snap->checks) {
+        json.key(check.name).beginObject().field<"ok">(check.ok).field<"latency_us">(check.latency.count());
+        if (!check.detail.empty()) json.field<"detail">(check.detail);
+        json.endObject();
+    }
+    json.endObject().endObject();
+    snap->body = json.take();
+    return snap;
+}
+
+} // namespace
+
+HealthService& HealthService::getInstance() {
+    static HealthService instance;
+    return instance;
+}
+
+HealthService::HealthService() {
+    m_snapshot.store(makeSnapshot("starting", {}));
+}
+
+HealthService::~HealthService() {
+    stop();
+}
+
+void HealthService::start() {
+    if (m_thread.joinable()) return;
+
+    auto& config = rz::utils::AppConfig::getInstance();
+    m_interval = std::chrono::seconds(std::max(1, config.getInt("HEALTH_PROBE_INTERVAL_SEC", 5)));
+    m_smtpTimeout = std::chrono::milliseconds(std::max(50, config.getInt("HEALTH_SMTP_TIMEOUT_MS", 1000)));
+    auto check_smtp = config.getBool("HEALTH_CHECK_SMTP", true);
+    if (!check_smtp) spdlog::warn("{}", check_smtp.error());
+    m_checkSmtp = check_smtp.value_or(true);
+
+    m_thread = std::jthread([this](std::stop_token token) { run(token); });
+    spdlog::info("Health prober started (interval {}s)", m_interval.count());
+}
+
+void HealthService::stop() {
+    if (!m_thread.joinable()) return;
+    m_thread.request_stop();
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+bool HealthService::waitForFirstProbe(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(m_mutex);
+    return m_probedCv.wait_for(lock, timeout, [this] { return m_probed; });
+}
+
+std::shared_ptr<const HealthSnapshot> HealthService::snapshot() const {
+    return m_snapshot.load(std::memory_order_acquire);
+}
+
+void HealthService::run(std::stop_token token) {
+    while (!token.stop_requested()) {
+        probeOnce();
+
+        std::unique_lock lock(m_mutex);
+        m_cv.wait_for(lock, token, m_interval, [] { return false; });
+    }
+}
+
+void HealthService::probeOnce() {
+    std::vector<HealthCheckResult> checks;
+    checks.reserve(3);
+    checks.push_back(checkDatabase());
+    if (m_checkSmtp) checks.push_back(checkSmtp());
+    checks.push_back(checkTemplates());
+
+    // The database is required to serve requests; the rest only degrades features.
+    std::string status = "ok";
+    for (const auto& check : checks) {
+        if (check.ok) continue;
+        if (check.name == "database") {
+            status = "down";
+            break;
+        }
+        status = "degraded";
+    }
+
+    auto previous = m_snapshot.load(std::memory_order_relaxed);
+    if (previous->status != status) {
+        spdlog::info("Health status changed: {} -> {}", previous->status, status);
+    }
+    m_snapshot.store(makeSnapshot(std::move(status), std::move(checks)), std::memory_order_release);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_probed = true;
+    }
+    m_probedCv.notify_all();
+}
+
+HealthCheckResult HealthService::checkDatabase() {
+    auto start = Clock::now();
+    auto res = DatabaseService::getInstance().ping();
+    return {"database", res.has_value(), elapsedSince(start), res ? std::string{} : res.error()};
+}
+
+HealthCheckResult HealthService::checkSmtp() {
+    auto& config = rz::utils::AppConfig::getInstance();
+    std::string host = config.getString("SMTP_SERVER", "localhost");
+    int port = config.getInt("SMTP_PORT", 587);
+
+    auto start = Clock::now();
+    std::string error = tcpConnect(host, port, m_smtpTimeout);
+    return {"smtp", error.empty(), elapsedSince(start), error};
+}
+
+HealthCheckResult HealthService::checkTemplates() {
+    auto& config = rz::utils::AppConfig::getInstance();
+    std::filesystem::path dir = config.getString("MAIL_TEMPLATE_DIR", "./data/templates");
+
+    auto start = Clock::now();
+    std::error_code ec;
+    std::string detail;
+    if (!std::filesystem::is_directory(dir, ec)) {
+        detail = "template directory missing: " + dir.string();
+    } else if (::access((dir / "email_template_en.html").c_str(), R_OK) != 0) {
+        detail = "default template not readable";
+    }
+    return {"templates", detail.empty(), elapsedSince(start), detail};
+}
+
+} // namespace rz::services
@@ -0,0 +1,206 @@
+/**
+ * SPDX-FileComment: Metrics Service Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file metrics_service.cpp
+ * @brief Implementation of MetricsService.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/metrics_service.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <format>
+
+namespace rz::services {
+
+namespace {
+
+// Series 0 is a sink for registrations beyond MAX_SERIES; it is never exported.
+constexpr SeriesId OVERFLOW_SERIES = 0;
+
+// Single writer per shard: a relaxed load/store pair avoids the locked RMW.
+inline void bump(std::atomic<std::uint64_t>& cell, std::uint64_t value) noexcept {
+    cell.store(cell.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+std::size_t bucketIndex(std::uint64_t micros) noexcept {
+    const auto& bounds = MetricsService::BUCKET_BOUNDS_US;
+    return static_cast<std::size_t>(std::lower_bound(bounds.begin(), bounds.end(), micros) - bounds.begin());
+}
+
+std::string withLabels(const std::string& labels, std::string_view extra = {}) {
+    if (labels.empty() && extra.empty()) return {};
+    std::string out = "{" + labels;
+    if (!labels.empty() && !extra.empty()) out += ",";
+    out += extra;
+    out += "}";
+    return out;
+}
+
+} // namespace
+
+/**
+ * @brief Hands the thread's shard back to the free list when the thread exits.
+ *
+ * Counts stay in the shard, so totals remain monotonic after thread churn.
+ */
+struct ShardOwner {
+    MetricsService::Shard* shard = nullptr;
+    ~ShardOwner() {
+        if (shard) MetricsService::getInstance().releaseShard(shard);
+    }
+};
+
+MetricsService& MetricsService::getInstance() {
+    static MetricsService instance;
+    return instance;
+}
+
+SeriesId MetricsService::registerHistogram(const std::string& name, const std::string& help, const std::string& labels) {
+    return registerSeries(name, help, labels, Kind::Histogram);
+}
+
+SeriesId MetricsService::registerCounter(const std::string& name, const std::string& help, const std::string& labels) {
+    return registerSeries(name, help, labels, Kind::Counter);
+}
+
+SeriesId MetricsService::registerSeries(const std::string& name, const std::string& help, const std::string& labels, Kind kind) {
+    std::lock_guard lock(m_mutex);
+    std::size_t count = m_seriesCount.load(std::memory_order_relaxed);
+    if (count == 0) count = 1; // reserve the overflow sink
+
+    for (std::size_t i = 1; i < count; ++i) {
+        if (m_series[i].name == name && m_series[i].labels == labels) {
+            return static_cast<SeriesId>(i);
+        }
+    }
+    if (count >= MAX_SERIES) {
+        spdlog::warn("Metrics: series limit reached, dropping {}{{{}}}", name, labels);
+        return OVERFLOW_SERIES;
+    }
+
+    m_series[count] = Descriptor{name, help, labels, kind};
+    m_seriesCount.store(count + 1, std::memory_order_release);
+    return static_cast<SeriesId>(count);
+}
+
+void MetricsService::addCollector(std::function<void(std::string&)> collector) {
+    std::lock_guard lock(m_mutex);
+    m_collectors.push_back(std::move(collector));
+}
+
+MetricsService::Shard& MetricsService::localShard() noexcept {
+    thread_local ShardOwner owner;
+    if (!owner.shard) [[unlikely]] {
+        // First sample of this thread: reuse a shard of an exited thread or allocate one.
+        std::lock_guard lock(m_mutex);
+        if (!m_freeShards.empty()) {
+            owner.shard = m_freeShards.back();
+            m_freeShards.pop_back();
+        } else {
+            owner.shard = new Shard();
+            m_shards.push_back(owner.shard);
+        }
+    }
+    return *owner.shard;
+}
+
+void MetricsService::releaseShard(Shard* shard) {
+    std::lock_guard lock(m_mutex);
+    m_freeShards.push_back(shard);
+}
+
+void MetricsService::observe(SeriesId id, std::chrono::nanoseconds latency) noexcept {
+    auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(0, latency.count()));
+    Cell& cell = localShard().cells[id];
+    bump(cell.buckets[bucketIndex(ns / 1000)], 1);
+    bump(cell.count, 1);
+    bump(cell.sum_ns, ns);
+}
+
+void MetricsService::increment(SeriesId id, std::uint64_t value) noexcept {
+    bump(localShard().cells[id].count, value);
+}
+
+std::string MetricsService::scrape() const {
+    const std::size_t count = m_seriesCount.load(std::memory_order_acquire);
+
+    std::vector<Shard*> shards;
+    std::vector<std::function<void(std::string&)>> collectors;
+    {
+        std::lock_guard lock(m_mutex);
+        shards = m_shards;
+        collectors = m_collectors;
+    }
+
+    // Sum up all shards per series
+    struct Totals {
+        std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+        std::uint64_t count = 0;
+        std::uint64_t sum_ns = 0;
+    };
+    std::vector<Totals> totals(count);
+    for (const Shard* shard : shards) {
+        for (std::size_t i = 1; i < count; ++i) {
+            const Cell& cell = shard->cells[i];
+            for (std::size_t b = 0; b < BUCKET_COUNT; ++b) {
+                totals[i].buckets[b] += cell.buckets[b].load(std::memory_order_relaxed);
+            }
+            totals[i].count += cell.count.load(std::memory_order_relaxed);
+            totals[i].sum_ns += cell.sum_ns.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::string out;
+    out.reserve(count * 512);
+    std::vector<bool> emitted(count, false);
+    for (std::size_t i = 1; i < count; ++i) {
+        if (emitted[i]) continue;
+        const Descriptor& family = m_series[i];
+        const bool histogram = family.kind == Kind::Histogram;
+        out += std::format("# HELP {} {}\n# TYPE {} {}\n", family.name, family.help, family.name,
+                           histogram ? "histogram" : "counter");
+
+        // Emit all series of the same family together
+        for (std::size_t j = i; j < count; ++j) {
+            if (emitted[j] || m_series[j].name != family.name) continue;
+            emitted[j] = true;
+            const Descriptor& series = m_series[j];
+            const Totals& t = totals[j];
+
+            if (!histogram) {
+                out += std::format("{}{} {}\n", series.name, withLabels(series.labels), t.count);
+                continue;
+            }
+
+            std::uint64_t cumulative = 0;
+            for (std::size_t b = 0; b < BUCKET_BOUNDS_US.size(); ++b) {
+                cumulative += t.buckets[b];
+                out += std::format("{}_bucket{} {}\n", series.name,
+                                   withLabels(series.labels, std::format("le=\"{}\"", BUCKET_BOUNDS_US[b] / 1e6)),
+                                   cumulative);
+            }
+            cumulative += t.buckets[BUCKET_COUNT - 1];
+            out += std::format("{}_bucket{} {}\n", series.name, withLabels(series.labels, "le=\"+Inf\""), cumulative);
+            out += std::format("{}_sum{} {}\n", series.name, withLabels(series.labels), t.sum_ns / 1e9);
+            out += std::format("{}_count{} {}\n", series.name, withLabels(series.labels), t.count);
+        }
+    }
+
+    for (const auto& collector : collectors) {
+        collector(out);
+    }
+    return out;
+}
+
+} // namespace rz::services
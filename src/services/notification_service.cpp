@@ -7,8 +7,8 @@
  *
  * @file notification_service.cpp
  * @brief Implementation of NotificationService.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.5
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -19,11 +19,15 @@
 #include "services/notification_service.hpp"
 #include "services/database_service.hpp"
 #include "services/smtp_service.hpp"
+#include "services/event_hub.hpp"
+#include "services/push_service.hpp"
+#include "utils/trace.hpp"
 #include <spdlog/spdlog.h>
 
 namespace rz::services {
 
 std::expected<void, std::string> NotificationService::notifyUser(const std::string& user_uuid, nlohmann::json data) {
+    rz::utils::TraceSpan span("notify.user");
     auto& db = DatabaseService::getInstance();
 
     // 1. Fetch User
@@ -48,9 +52,25 @@ std::expected<void, std::string> NotificationService::notifyUser(const std::stri
     }
 
     bool notified_any = false;
+    const char* channel = "none";
 
-    // 4. Dispatch Email
-    if (config.email_enabled) {
+    // 4. Dispatch Push (serialized once for all live sockets of the user)
+    if (config.push_enabled) {
+        nlohmann::json push;
+        push["type"] = "notification";
+        push["data"] = data;
+        auto delivered = PushService::getInstance().send(user_uuid, push.dump());
+        if (delivered > 0) {
+            spdlog::info("Pushed notification to {} socket(s) of {}", delivered, user.name);
+            notified_any = true;
+            channel = "push";
+        } else {
+            spdlog::debug("Push enabled for {}, but no live socket", user.name);
+        }
+    }
+
+    // 5. Dispatch Email, as the fallback when no push reached the user
+    if (config.email_enabled && !notified_any) {
         // Check if user wants HTML or Plain Text (SmtpService currently assumes HTML template, 
         // but we can pass a flag or choose a different template if needed. 
         // For this implementation, we simply send the standard email.)
@@ -59,17 +79,15 @@ std::expected<void, std::string> NotificationService::notifyUser(const std::stri
         auto email_res = SmtpService::sendEmail(user.email, config.language, data);
         if (!email_res) {
             spdlog::error("Failed to send email to {}: {}", user.email, email_res.error());
-            // We don't return here, we try other channels if available
         } else {
             notified_any = true;
+            channel = "email";
         }
     }
 
-    // 5. Dispatch Push (Placeholder)
-    if (config.push_enabled) {
-        spdlog::info("Push notification enabled for User {}, but service not implemented yet.", user.name);
-        // Implement push logic here...
-    }
+    // 6. Live event for SSE subscribers (serialized once, shared by all streams). The stream
+    // is public, so the event carries nothing that identifies the user or the message.
+    EventHub::getInstance().publish("notification", {{"channel", channel}});
 
     if (!notified_any && config.email_enabled) {
         return std::unexpected("Failed to send notification via enabled channels.");
@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileComment: Push Service Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file push_service.cpp
+ * @brief Implementation of PushService.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/push_service.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/app_config.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <format>
+#include <functional>
+
+namespace rz::services {
+
+namespace {
+
+SeriesId sentSeries() {
+    static const auto series = MetricsService::getInstance().registerCounter(
+        "rz_push_messages_total", "Push messages queued on WebSocket connections.");
+    return series;
+}
+
+} // namespace
+
+PushService& PushService::getInstance() {
+    static PushService instance;
+    return instance;
+}
+
+PushService::PushService() {
+    MetricsService::getInstance().addCollector([this](std::string& out) {
+        out += "# HELP rz_push_connections Live WebSocket push connections.\n"
+               "# TYPE rz_push_connections gauge\n";
+        out += std::format("rz_push_connections {}\n", connections());
+    });
+}
+
+void PushService::configure() {
+    auto& config = rz::utils::AppConfig::getInstance();
+    m_maxPerUser = static_cast<std::size_t>(std::max(1, config.getInt("PUSH_MAX_SOCKETS_PER_USER", 8)));
+}
+
+PushService::Shard& PushService::shardFor(std::string_view user_uuid) {
+    return m_shards[std::hash<std::string_view>{}(user_uuid) % SHARD_COUNT];
+}
+
+bool PushService::add(const std::string& user_uuid, crow::websocket::connection* conn) {
+    auto& shard = shardFor(user_uuid);
+    std::lock_guard lock(shard.mutex);
+    auto& sockets = shard.users[user_uuid];
+    if (sockets.size() >= m_maxPerUser) {
+        return false;
+    }
+    sockets.push_back(conn);
+    m_connections.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void PushService::remove(const std::string& user_uuid, crow::websocket::connection* conn) {
+    auto& shard = shardFor(user_uuid);
+    std::lock_guard lock(shard.mutex);
+    auto it = shard.users.find(user_uuid);
+    if (it == shard.users.end()) return;
+
+    auto& sockets = it->second;
+    auto pos = std::find(sockets.begin(), sockets.end(), conn);
+    if (pos == sockets.end()) return;
+    *pos = sockets.back();
+    sockets.pop_back();
+    m_connections.fetch_sub(1, std::memory_order_relaxed);
+    if (sockets.empty()) {
+        shard.users.erase(it);
+    }
+}
+
+std::size_t PushService::send(const std::string& user_uuid, const std::string& payload) {
+    auto& shard = shardFor(user_uuid);
+    std::size_t sent = 0;
+    {
+        // Held while queueing so a socket cannot be unregistered (and freed) mid-send
+        std::lock_guard lock(shard.mutex);
+        auto it = shard.users.find(user_uuid);
+        if (it == shard.users.end()) return 0;
+        for (auto* conn : it->second) {
+            conn->send_text(payload);
+            ++sent;
+        }
+    }
+    MetricsService::getInstance().increment(sentSeries(), sent);
+    return sent;
+}
+
+} // namespace rz::services
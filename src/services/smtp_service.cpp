@@ -7,8 +7,8 @@
  *
  * @file smtp_service.cpp
  * @brief Implementation of SmtpService.
- * @version 0.1.0
- * @date 2026-01-31
+ * @version 0.1.4
+ * @date 2026-10-18
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -17,7 +17,9 @@
  */
 
 #include "services/smtp_service.hpp"
+#include "services/metrics_service.hpp"
 #include "utils/app_config.hpp"
+#include "utils/trace.hpp"
 #include <mailio/message.hpp>
 #include <mailio/smtp.hpp>
 #include <mailio/dialog.hpp> // Required for ssl_options_t
@@ -26,61 +28,138 @@
 #include <spdlog/spdlog.h>
 #include <filesystem>
 #include <fstream>
+#include <shared_mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace rz::services {
 
-std::expected<void, std::string> SmtpService::sendEmail(
-    const std::string& to_email, 
-    const std::string& lang, 
-    const nlohmann::json& data
-) {
-    auto& config = rz::utils::AppConfig::getInstance();
+namespace {
 
-    // 1. Get SMTP Config
-    std::string smtp_server = config.getString("SMTP_SERVER", "localhost");
-    int smtp_port = config.getInt("SMTP_PORT", 587);
-    std::string smtp_user = config.getString("SMTP_USERNAME", "");
-    std::string smtp_pass = config.getString("SMTP_PASSWORD", "");
-    std::string smtp_from = config.getString("SMTP_FROM", "");
-    std::string starttls_str = config.getString("SMTP_STARTTLS", "true");
-    bool use_starttls = (starttls_str == "true" || starttls_str == "1");
+// Parsed templates by path. Parsing is most of the rendering cost, so templates are
+// parsed once (preloaded at startup) and re-parsed only when the file changes.
+struct CachedTemplate {
+    inja::Template tmpl;
+    std::filesystem::file_time_type mtime;
+};
 
-    // 2. Determine Template Path
-    std::string template_dir_path = config.getString("MAIL_TEMPLATE_DIR", "./data/templates");
+struct TemplateCache {
+    std::shared_mutex mutex;
+    inja::Environment env;
+    std::unordered_map<std::string, CachedTemplate> templates;
+};
+
+TemplateCache& templateCache() {
+    static TemplateCache cache;
+    return cache;
+}
+
+std::filesystem::path templateDir() {
+    return rz::utils::AppConfig::getInstance().getString("MAIL_TEMPLATE_DIR", "./data/templates");
+}
+
+} // namespace
+
+std::expected<std::size_t, std::string> SmtpService::preloadTemplates() {
+    const std::filesystem::path dir = templateDir();
+    std::error_code ec;
+    std::filesystem::directory_iterator it(dir, ec);
+    if (ec) return std::unexpected("Template directory " + dir.string() + ": " + ec.message());
+
+    auto& cache = templateCache();
+    std::size_t count = 0;
+    for (const auto& entry : it) {
+        const std::string name = entry.path().filename().string();
+        if (!entry.is_regular_file() || !name.starts_with("email_template_") || !name.ends_with(".html")) continue;
+        try {
+            CachedTemplate parsed{cache.env.parse_template(entry.path().string()), entry.last_write_time()};
+            std::unique_lock lock(cache.mutex);
+            cache.templates.insert_or_assign(entry.path().string(), std::move(parsed));
+            ++count;
+        } catch (const std::exception& e) {
+            return std::unexpected("Template " + name + ": " + e.what());
+        }
+    }
+    return count;
+}
+
+std::expected<std::string, std::string> SmtpService::renderBody(const std::string& lang, const nlohmann::json& data) {
+    std::filesystem::path template_dir_path = templateDir();
     std::string target_lang = lang.empty() ? "en" : lang;
-    
+
     std::string template_filename = "email_template_" + target_lang + ".html";
-    std::filesystem::path template_path = std::filesystem::path(template_dir_path) / template_filename;
+    std::filesystem::path template_path = template_dir_path / template_filename;
 
     if (!std::filesystem::exists(template_path)) {
         if (target_lang != "en") {
-            template_path = std::filesystem::path(template_dir_path) / "email_template_en.html";
+            template_path = template_dir_path / "email_template_en.html";
         }
-        
+
         if (!std::filesystem::exists(template_path)) {
-            std::string err = "Template not found: " + template_path.string();
-            spdlog::error(err);
-            return std::unexpected(err);
+            return std::unexpected("Template not found: " + template_path.string());
         }
     }
 
-    // 3. Render Template
     nlohmann::json render_data = data;
     if (!render_data.contains("has_link")) render_data["has_link"] = false;
     if (!render_data.contains("title")) render_data["title"] = "Notification";
 
-    std::string rendered_body;
     try {
-        inja::Environment env;
-        rendered_body = env.render_file(template_path.string(), render_data);
+        rz::utils::TraceSpan render_span("smtp.render_template");
+        auto& cache = templateCache();
+        const std::string key = template_path.string();
+        const auto mtime = std::filesystem::last_write_time(template_path);
+        {
+            std::shared_lock lock(cache.mutex);
+            if (auto it = cache.templates.find(key); it != cache.templates.end() && it->second.mtime == mtime) {
+                return cache.env.render(it->second.tmpl, render_data);
+            }
+        }
+        std::unique_lock lock(cache.mutex);
+        auto& entry = cache.templates.insert_or_assign(key, CachedTemplate{cache.env.parse_template(key), mtime})
+                          .first->second;
+        return cache.env.render(entry.tmpl, render_data);
     } catch (const std::exception& e) {
-        std::string err = "Template rendering failed: " + std::string(e.what());
-        spdlog::error(err);
-        return std::unexpected(err);
+        return std::unexpected("Template rendering failed: " + std::string(e.what()));
+    }
+}
+
+std::expected<void, std::string> SmtpService::sendEmail(
+    const std::string& to_email, 
+    const std::string& lang, 
+    const nlohmann::json& data
+) {
+    auto& metrics = MetricsService::getInstance();
+    static const SeriesId send_series = metrics.registerHistogram(
+        "rz_smtp_send_duration_seconds", "Latency of email rendering and SMTP submission.");
+    static const SeriesId failure_series = metrics.registerCounter(
+        "rz_smtp_send_failures_total", "Failed email sends.");
+    MetricsTimer timer(send_series);
+    rz::utils::TraceSpan span("smtp.send_email");
+
+    auto& config = rz::utils::AppConfig::getInstance();
+
+    // 1. Get SMTP Config
+    std::string smtp_server = config.getString("SMTP_SERVER", "localhost");
+    int smtp_port = config.getInt("SMTP_PORT", 587);
+    std::string smtp_user = config.getString("SMTP_USERNAME", "");
+    std::string smtp_pass = config.getString("SMTP_PASSWORD", "");
+    std::string smtp_from = config.getString("SMTP_FROM", "");
+    auto starttls = config.getBool("SMTP_STARTTLS", true);
+    if (!starttls) spdlog::warn("{}", starttls.error());
+    bool use_starttls = starttls.value_or(true);
+
+    // 2. Render Template
+    std::string target_lang = lang.empty() ? "en" : lang;
+    auto rendered = renderBody(target_lang, data);
+    if (!rendered) {
+        spdlog::error(rendered.error());
+        metrics.increment(failure_series);
+        return std::unexpected(rendered.error());
     }
+    std::string rendered_body = std::move(*rendered);
 
-    // 4. Construct Message
+    // 3. Construct Message
     try {
         mailio::message msg;
         msg.from(mailio::mail_address("App Server", smtp_from));
@@ -96,7 +175,8 @@ std::expected<void, std::string> SmtpService::sendEmail(
         msg.content_type(mailio::message::media_type_t::TEXT, "html", "utf-8");
         msg.content(rendered_body);
 
-        // 5. Send via SMTP
+        // 4. Send via SMTP
+        rz::utils::TraceSpan submit_span("smtp.submit");
         if (use_starttls) {
             mailio::smtps conn(smtp_server, smtp_port);
             
@@ -119,6 +199,7 @@ std::expected<void, std::string> SmtpService::sendEmail(
     } catch (const std::exception& e) {
         std::string err = "SMTP Error: " + std::string(e.what());
         spdlog::error(err);
+        metrics.increment(failure_series);
         return std::unexpected(err);
     }
 
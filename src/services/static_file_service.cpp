@@ -0,0 +1,276 @@
+/**
+ * SPDX-FileComment: Static File Service Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file static_file_service.cpp
+ * @brief Implementation of StaticFileService.
+ * @version 0.1.3
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "services/static_file_service.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/app_config.hpp"
+#include "utils/http_cache.hpp"
+#include "utils/trace.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace rz::services {
+
+namespace {
+
+struct Variant {
+    std::string_view encoding;
+    std::string_view extension;
+};
+
+// Preference order for precompressed siblings
+constexpr Variant VARIANTS[] = {{"br", ".br"}, {"gzip", ".gz"}};
+
+// Rejects traversal ("..") and hidden files; the root itself is never served
+bool isSafePath(std::string_view relative) {
+    if (relative.empty() || relative.front() == '/' || relative.find('\0') != std::string_view::npos) {
+        return false;
+    }
+    while (!relative.empty()) {
+        auto slash = relative.find('/');
+        std::string_view segment = relative.substr(0, slash);
+        if (segment.empty() || segment.front() == '.' || segment.find('\\') != std::string_view::npos) {
+            return false;
+        }
+        if (slash == std::string_view::npos) break;
+        relative.remove_prefix(slash + 1);
+    }
+    return true;
+}
+
+std::string contentTypeFor(std::string_view path) {
+    auto dot = path.rfind('.');
+    if (dot != std::string_view::npos && path.find('/', dot) == std::string_view::npos) {
+        std::string ext(path.substr(dot + 1));
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (auto it = crow::mime_types.find(ext); it != crow::mime_types.end()) {
+            return it->second;
+        }
+    }
+    return "application/octet-stream";
+}
+
+SeriesId cacheSeries(bool hit) {
+    auto& metrics = MetricsService::getInstance();
+    static const auto hits = metrics.registerCounter(
+        "rz_static_cache_requests_total", "Static file cache lookups.", "result=\"hit\"");
+    static const auto misses = metrics.registerCounter(
+        "rz_static_cache_requests_total", "Static file cache lookups.", "result=\"miss\"");
+    return hit ? hits : misses;
+}
+
+} // namespace
+
+StaticFileService& StaticFileService::getInstance() {
+    static StaticFileService instance;
+    return instance;
+}
+
+StaticFileService::StaticFileService()
+    : m_memory(rz::utils::MemoryAccounting::getInstance().account(
+          "static_cache", [this](std::size_t target) { return shrink(target); })) {
+    MetricsService::getInstance().addCollector([this](std::string& out) {
+        out += "# HELP rz_static_cache_bytes Bytes held by the static file cache.\n"
+               "# TYPE rz_static_cache_bytes gauge\n";
+        out += std::format("rz_static_cache_bytes {}\n", cachedBytes());
+    });
+}
+
+void StaticFileService::configure() {
+    auto& config = rz::utils::AppConfig::getInstance();
+    m_root = config.getString("STATIC_DIR", "./data/static");
+    m_maxBytes = static_cast<std::size_t>(std::max(0, config.getInt("STATIC_CACHE_MAX_BYTES", 32 * 1024 * 1024)));
+    m_maxFileBytes = static_cast<std::size_t>(std::max(0, config.getInt("STATIC_CACHE_FILE_MAX_BYTES", 256 * 1024)));
+    m_maxAgeSec = std::max(0, config.getInt("STATIC_MAX_AGE_SEC", 3600));
+    clear();
+
+#ifdef RZ_HAVE_SENDFILE
+    constexpr const char* large_path = "sendfile";
+#else
+    constexpr const char* large_path = "buffered";
+#endif
+    spdlog::info("Static files: {} (cache {} KiB, files up to {} KiB in memory, larger files {})",
+                 m_root.string(), m_maxBytes / 1024, m_maxFileBytes / 1024, large_path);
+}
+
+void StaticFileService::serve(const crow::request& req, crow::response& res, std::string_view relative) {
+    rz::utils::TraceSpan span("static.serve");
+
+    if (!isSafePath(relative)) {
+        res.code = 403;
+        return;
+    }
+
+    const std::string path = (m_root / relative).string();
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        res.code = 404;
+        return;
+    }
+
+    // Prefer a precompressed sibling that is at least as new as the original
+    std::string served = path;
+    std::string_view encoding;
+    const auto& accept_encoding = req.get_header_value("Accept-Encoding");
+    for (const auto& variant : VARIANTS) {
+        if (!rz::utils::HttpCache::acceptsEncoding(accept_encoding, variant.encoding)) continue;
+        std::string candidate = path + std::string(variant.extension);
+        struct stat vst{};
+        if (::stat(candidate.c_str(), &vst) == 0 && S_ISREG(vst.st_mode) && vst.st_mtime >= st.st_mtime) {
+            served = std::move(candidate);
+            encoding = variant.encoding;
+            st = vst;
+            break;
+        }
+    }
+
+    const auto size = static_cast<std::uintmax_t>(st.st_size);
+    const std::time_t mtime = st.st_mtime;
+    const auto mtime_ns = static_cast<std::uint64_t>(st.st_mtim.tv_sec) * 1'000'000'000ULL +
+                          static_cast<std::uint64_t>(st.st_mtim.tv_nsec);
+    const std::string etag = encoding.empty() ? std::format("\"{:x}-{:x}\"", size, mtime_ns)
+                                              : std::format("\"{:x}-{:x}-{}\"", size, mtime_ns, encoding);
+
+    res.set_header("ETag", etag);
+    res.set_header("Last-Modified", rz::utils::HttpCache::httpDate(mtime));
+    res.set_header("Cache-Control", std::format("public, max-age={}", m_maxAgeSec));
+    res.set_header("Vary", "Accept-Encoding");
+
+    // If-None-Match takes precedence over If-Modified-Since (RFC 9110 13.2.2)
+    const auto& if_none_match = req.get_header_value("If-None-Match");
+    bool not_modified = if_none_match.empty()
+                            ? rz::utils::HttpCache::notModifiedSince(req.get_header_value("If-Modified-Since"), mtime)
+                            : rz::utils::HttpCache::ifNoneMatch(if_none_match, etag);
+    if (not_modified) {
+        res.code = 304;
+        return;
+    }
+
+    const std::string content_type = contentTypeFor(path);
+    if (!encoding.empty()) {
+        res.set_header("Content-Encoding", std::string(encoding));
+    }
+
+    if (size > m_maxFileBytes) {
+        // Crow streams the file itself (sendfile(2) with the patched connection)
+        res.set_static_file_info_unsafe(served, content_type);
+        return;
+    }
+
+    auto file = lookup(served, size, mtime);
+    if (!file) {
+        file = load(served, size, mtime);
+        if (!file) {
+            res.code = 404;
+            return;
+        }
+    }
+    res.code = 200;
+    res.set_header("Content-Type", content_type);
+    res.body = file->body;
+}
+
+std::shared_ptr<const CachedFile> StaticFileService::lookup(const std::string& path, std::uintmax_t size,
+                                                            std::time_t mtime) {
+    auto& metrics = MetricsService::getInstance();
+    std::lock_guard lock(m_mutex);
+    auto it = m_index.find(path);
+    if (it == m_index.end()) {
+        metrics.increment(cacheSeries(false));
+        return nullptr;
+    }
+    const auto& file = *it->second;
+    if (file->size != size || file->mtime != mtime) {
+        // Changed on disk: drop the stale copy, the caller reloads it
+        m_bytes -= file->body.size();
+        m_memory.set(m_bytes);
+        m_lru.erase(it->second);
+        m_index.erase(it);
+        metrics.increment(cacheSeries(false));
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    metrics.increment(cacheSeries(true));
+    return file;
+}
+
+std::shared_ptr<const CachedFile> StaticFileService::load(const std::string& path, std::uintmax_t size,
+                                                          std::time_t mtime) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return nullptr;
+
+    auto file = std::make_shared<CachedFile>();
+    file->path = path;
+    file->size = size;
+    file->mtime = mtime;
+    file->body.resize(static_cast<std::size_t>(size));
+    in.read(file->body.data(), static_cast<std::streamsize>(size));
+    if (static_cast<std::uintmax_t>(in.gcount()) != size) return nullptr;
+
+    if (file->body.size() > m_maxBytes) return file;
+
+    std::lock_guard lock(m_mutex);
+    if (auto it = m_index.find(path); it != m_index.end()) {
+        // Another thread loaded it concurrently; keep the newer copy
+        m_bytes -= (*it->second)->body.size();
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+    m_lru.push_front(file);
+    m_index.emplace(path, m_lru.begin());
+    m_bytes += file->body.size();
+    evictLocked(m_maxBytes);
+    return file;
+}
+
+void StaticFileService::evictLocked(std::size_t target) {
+    while (m_bytes > target && !m_lru.empty()) {
+        const auto& victim = m_lru.back();
+        m_bytes -= victim->body.size();
+        m_index.erase(victim->path);
+        m_lru.pop_back();
+    }
+    m_memory.set(m_bytes);
+}
+
+std::size_t StaticFileService::shrink(std::size_t target) {
+    std::lock_guard lock(m_mutex);
+    std::size_t before = m_bytes;
+    evictLocked(target);
+    return before - m_bytes;
+}
+
+void StaticFileService::clear() {
+    std::lock_guard lock(m_mutex);
+    m_lru.clear();
+    m_index.clear();
+    m_bytes = 0;
+    m_memory.set(0);
+}
+
+std::size_t StaticFileService::cachedBytes() const {
+    std::lock_guard lock(m_mutex);
+    return m_bytes;
+}
+
+} // namespace rz::services
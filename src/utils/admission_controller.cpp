@@ -0,0 +1,154 @@
+/**
+ * SPDX-FileComment: Admission Controller Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file admission_controller.cpp
+ * @brief Implementation of AdmissionController.
+ * @version 0.1.3
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/admission_controller.hpp"
+#include "utils/app_config.hpp"
+#include "utils/string_utils.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <format>
+#include <string_view>
+
+namespace rz::utils {
+
+namespace {
+
+constexpr double BACKOFF = 0.9; // Multiplicative decrease per congested window
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+AdmissionController& AdmissionController::getInstance() {
+    static AdmissionController instance;
+    return instance;
+}
+
+AdmissionController::AdmissionController() {
+    rz::services::MetricsService::getInstance().addCollector([this](std::string& out) {
+        out += "# HELP rz_admission_limit Current adaptive limit of requests in flight.\n"
+               "# TYPE rz_admission_limit gauge\n";
+        out += std::format("rz_admission_limit {}\n", limit());
+        out += "# HELP rz_admission_inflight Admitted requests in flight.\n"
+               "# TYPE rz_admission_inflight gauge\n";
+        out += std::format("rz_admission_inflight {}\n", inflight());
+    });
+}
+
+std::expected<void, std::string> AdmissionController::configure() {
+    auto& config = AppConfig::getInstance();
+
+    std::string errors;
+    auto enabled = config.getBool("ADMISSION_ENABLED", true);
+    if (!enabled) errors += enabled.error() + "; ";
+    m_enabled = enabled.value_or(true);
+    m_minLimit = std::max(1, config.getInt("ADMISSION_MIN_LIMIT", 4));
+    m_maxLimit = std::max(m_minLimit, config.getInt("ADMISSION_MAX_LIMIT", 1000));
+    m_limit.store(std::clamp(config.getInt("ADMISSION_INITIAL_LIMIT", 100), m_minLimit, m_maxLimit));
+    m_targetNs = std::int64_t{std::max(1, config.getInt("ADMISSION_LATENCY_TARGET_MS", 100))} * 1'000'000;
+    m_windowNs = std::int64_t{std::max(10, config.getInt("ADMISSION_WINDOW_MS", 200))} * 1'000'000;
+    m_retryAfter = std::max(1, config.getInt("ADMISSION_RETRY_AFTER_SEC", 1));
+    m_windowEnd.store(nowNs() + m_windowNs);
+    m_shedSeries = rz::services::MetricsService::getInstance().registerCounter(
+        "rz_admission_shed_total", "Requests shed with 503 by the admission limit.");
+
+    m_exempt.clear();
+    std::string routes = config.getString("ADMISSION_EXEMPT", "/system/health_check;/system/ready;/metrics;/api/events/stream");
+    for (std::string_view pattern : StringUtils::splitList(routes)) {
+        if (const RouteInfo* route = RouteRegistry::getInstance().find(pattern)) {
+            m_exempt.push_back(route);
+        } else {
+            errors += std::format("route '{}' is not registered; ", pattern);
+        }
+    }
+
+    if (m_enabled) {
+        spdlog::info("Admission control: limit {} (range {}..{}), latency target {} ms, {} exempt routes", limit(),
+                     m_minLimit, m_maxLimit, m_targetNs / 1'000'000, m_exempt.size());
+    }
+    if (!errors.empty()) {
+        errors.resize(errors.size() - 2);
+        return std::unexpected(errors);
+    }
+    return {};
+}
+
+bool AdmissionController::exempt(const RouteInfo& route) const noexcept {
+    return std::find(m_exempt.begin(), m_exempt.end(), &route) != m_exempt.end();
+}
+
+bool AdmissionController::tryAcquire() {
+    const int current = m_inflight.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (current > m_limit.load(std::memory_order_relaxed)) {
+        m_inflight.fetch_sub(1, std::memory_order_relaxed);
+        // A shed request means the window used the whole limit
+        m_peak.store(current, std::memory_order_relaxed);
+        rz::services::MetricsService::getInstance().increment(m_shedSeries);
+        return false;
+    }
+
+    int peak = m_peak.load(std::memory_order_relaxed);
+    while (current > peak && !m_peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    return true;
+}
+
+void AdmissionController::release(std::chrono::steady_clock::duration latency) {
+    m_inflight.fetch_sub(1, std::memory_order_relaxed);
+    m_sumNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(),
+                      std::memory_order_relaxed);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+
+    const std::int64_t now = nowNs();
+    if (now >= m_windowEnd.load(std::memory_order_relaxed)) {
+        adjust(now);
+    }
+}
+
+void AdmissionController::adjust(std::int64_t now_ns) {
+    std::unique_lock lock(m_adjustMutex, std::try_to_lock);
+    if (!lock.owns_lock() || now_ns < m_windowEnd.load(std::memory_order_relaxed)) {
+        return; // Another request is already closing this window
+    }
+    m_windowEnd.store(now_ns + m_windowNs, std::memory_order_relaxed);
+
+    const std::int64_t samples = m_samples.exchange(0, std::memory_order_relaxed);
+    const std::int64_t sum = m_sumNs.exchange(0, std::memory_order_relaxed);
+    const int peak = m_peak.exchange(m_inflight.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    if (samples == 0) return;
+
+    const int current = m_limit.load(std::memory_order_relaxed);
+    int next = current;
+    if (sum / samples > m_targetNs) {
+        next = std::max(m_minLimit, static_cast<int>(current * BACKOFF));
+    } else if (peak >= current) {
+        // Only grow a limit that was actually reached; an idle server keeps its limit
+        next = std::min(m_maxLimit, current + 1);
+    }
+    if (next != current) {
+        m_limit.store(next, std::memory_order_relaxed);
+        spdlog::debug("Admission limit {} -> {} (mean latency {} us, peak {})", current, next,
+                      sum / samples / 1000, peak);
+    }
+}
+
+} // namespace rz::utils
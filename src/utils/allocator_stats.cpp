@@ -0,0 +1,209 @@
+/**
+ * SPDX-FileComment: Allocator Stats Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file allocator_stats.cpp
+ * @brief Implementation of AllocatorStats.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/allocator_stats.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/json_writer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <limits>
+#include <unistd.h>
+
+#if defined(RZ_ALLOCATOR_MIMALLOC)
+#include <mimalloc.h>
+#elif defined(RZ_ALLOCATOR_JEMALLOC)
+#include <jemalloc/jemalloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace rz::utils {
+
+namespace {
+
+std::size_t residentBytes() {
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    unsigned long size = 0, resident = 0;
+    int fields = std::fscanf(statm, "%lu %lu", &size, &resident);
+    std::fclose(statm);
+    return fields == 2 ? resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) : 0;
+}
+
+#if defined(RZ_ALLOCATOR_JEMALLOC)
+
+template <typename T>
+T readCtl(const std::string& name) {
+    T value{};
+    std::size_t len = sizeof(value);
+    if (mallctl(name.c_str(), &value, &len, nullptr, 0) != 0) return T{};
+    return value;
+}
+
+#elif !defined(RZ_ALLOCATOR_MIMALLOC)
+
+// Value of the attribute `name="..."` of the first element starting at `pos`
+std::size_t xmlSize(const std::string& xml, std::size_t pos, std::size_t end, std::string_view element) {
+    auto at = xml.find(element, pos);
+    if (at == std::string::npos || at >= end) return 0;
+    auto size = xml.find("size=\"", at);
+    if (size == std::string::npos || size >= end) return 0;
+    return std::strtoull(xml.c_str() + size + 6, nullptr, 10);
+}
+
+// malloc_info() is the only glibc interface with a per-arena breakdown
+std::vector<AllocatorStats::Arena> glibcArenas() {
+    char* buffer = nullptr;
+    std::size_t length = 0;
+    std::FILE* stream = ::open_memstream(&buffer, &length);
+    if (!stream) return {};
+    ::malloc_info(0, stream);
+    std::fclose(stream);
+    std::string xml(buffer, length);
+    std::free(buffer);
+
+    std::vector<AllocatorStats::Arena> arenas;
+    for (auto pos = xml.find("<heap nr=\""); pos != std::string::npos; pos = xml.find("<heap nr=\"", pos)) {
+        auto end = xml.find("</heap>", pos);
+        if (end == std::string::npos) break;
+        AllocatorStats::Arena arena;
+        arena.index = std::strtoull(xml.c_str() + pos + 10, nullptr, 10);
+        arena.heap_bytes = xmlSize(xml, pos, end, "<system type=\"current\"");
+        std::size_t free_bytes =
+            xmlSize(xml, pos, end, "<total type=\"fast\"") + xmlSize(xml, pos, end, "<total type=\"rest\"");
+        arena.allocated_bytes = arena.heap_bytes > free_bytes ? arena.heap_bytes - free_bytes : 0;
+        arenas.push_back(arena);
+        pos = end;
+    }
+    return arenas;
+}
+
+#endif
+
+} // namespace
+
+double AllocatorStats::Snapshot::fragmentation() const {
+    if (!allocated_bytes || heap_bytes == 0) return std::numeric_limits<double>::quiet_NaN();
+    return 1.0 - static_cast<double>(std::min(*allocated_bytes, heap_bytes)) / static_cast<double>(heap_bytes);
+}
+
+AllocatorStats& AllocatorStats::getInstance() {
+    static AllocatorStats instance;
+    return instance;
+}
+
+AllocatorStats::AllocatorStats() {
+    rz::services::MetricsService::getInstance().addCollector([this](std::string& out) {
+        auto stats = snapshot(false);
+        out += "# HELP rz_allocator_heap_bytes Memory the allocator obtained from the OS.\n"
+               "# TYPE rz_allocator_heap_bytes gauge\n";
+        out += std::format("rz_allocator_heap_bytes{{allocator=\"{}\"}} {}\n", name(), stats.heap_bytes);
+        if (stats.allocated_bytes) {
+            out += "# HELP rz_allocator_allocated_bytes Memory handed out to the application.\n"
+                   "# TYPE rz_allocator_allocated_bytes gauge\n";
+            out += std::format("rz_allocator_allocated_bytes{{allocator=\"{}\"}} {}\n", name(),
+                               *stats.allocated_bytes);
+        }
+    });
+}
+
+std::string_view AllocatorStats::name() {
+#if defined(RZ_ALLOCATOR_MIMALLOC)
+    return "mimalloc";
+#elif defined(RZ_ALLOCATOR_JEMALLOC)
+    return "jemalloc";
+#else
+    return "system";
+#endif
+}
+
+AllocatorStats::Snapshot AllocatorStats::snapshot(bool arenas) const {
+    Snapshot stats;
+    stats.resident_bytes = residentBytes();
+
+#if defined(RZ_ALLOCATOR_MIMALLOC)
+    // Committed memory is what mimalloc holds. Live allocations stay unknown: thread heaps are not
+    // enumerable and mi_stats are per thread until merged, so the I/O threads would be missing
+    std::size_t elapsed, user, system, rss, peak_rss, commit, peak_commit, faults;
+    mi_process_info(&elapsed, &user, &system, &rss, &peak_rss, &commit, &peak_commit, &faults);
+    stats.heap_bytes = commit;
+    (void)arenas;
+#elif defined(RZ_ALLOCATOR_JEMALLOC)
+    // Statistics are cached by jemalloc until the epoch is advanced
+    std::uint64_t epoch = 1;
+    mallctl("epoch", nullptr, nullptr, &epoch, sizeof(epoch));
+    stats.heap_bytes = readCtl<std::size_t>("stats.resident");
+    stats.allocated_bytes = readCtl<std::size_t>("stats.allocated");
+    if (arenas) {
+        auto count = readCtl<unsigned>("arenas.narenas");
+        for (unsigned i = 0; i < count; ++i) {
+            const std::string prefix = std::format("stats.arenas.{}.", i);
+            Arena arena;
+            arena.index = i;
+            arena.heap_bytes = readCtl<std::size_t>(prefix + "resident");
+            arena.allocated_bytes =
+                readCtl<std::size_t>(prefix + "small.allocated") + readCtl<std::size_t>(prefix + "large.allocated");
+            arena.threads = readCtl<unsigned>(prefix + "nthreads");
+            // Arenas are created lazily; the unused ones are left out
+            if (arena.heap_bytes != 0 || *arena.threads != 0) stats.arenas.push_back(arena);
+        }
+    }
+#else
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = ::mallinfo2();
+#else
+    struct mallinfo info = ::mallinfo(); // int fields, wrap above 2 GiB
+#endif
+    // Large blocks are mmap()ed directly (hblkhd) and are both heap and allocated
+    stats.heap_bytes = static_cast<std::size_t>(info.arena) + static_cast<std::size_t>(info.hblkhd);
+    stats.allocated_bytes = static_cast<std::size_t>(info.uordblks) + static_cast<std::size_t>(info.hblkhd);
+    if (arenas) stats.arenas = glibcArenas();
+#endif
+    return stats;
+}
+
+std::string AllocatorStats::toJson() const {
+    auto stats = snapshot(true);
+    JsonWriter json(256 + stats.arenas.size() * 96);
+    json.beginObject()
+        .field<"allocator">(name())
+        .field<"resident_bytes">(stats.resident_bytes)
+        .field<"heap_bytes">(stats.heap_bytes);
+    if (stats.allocated_bytes) {
+        json.field<"allocated_bytes">(*stats.allocated_bytes);
+    } else {
+        json.field<"allocated_bytes">(nullptr);
+    }
+    json.field<"fragmentation">(stats.fragmentation()).key<"arenas">().beginArray();
+    for (const auto& arena : stats.arenas) {
+        json.beginObject()
+            .field<"index">(arena.index)
+            .field<"heap_bytes">(arena.heap_bytes)
+            .field<"allocated_bytes">(arena.allocated_bytes);
+        if (arena.threads) json.field<"threads">(*arena.threads);
+        json.endObject();
+    }
+    json.endArray().endObject();
+    return json.take();
+}
+
+} // namespace rz::utils
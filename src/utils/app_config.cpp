@@ -7,7 +7,7 @@
  *
  * @file app_config.cpp
  * @brief Implementation of AppConfig class.
- * @version 0.1.0
+ * @version 0.1.1
  * @date 2026-01-31
  *
  * @author ZHENG Robert (robert@hase-zheng.net)
@@ -19,6 +19,8 @@
 #include "utils/app_config.hpp"
 
 #include <dotenv.h>
+#include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <print>
 #include <filesystem>
@@ -62,6 +64,17 @@ std::string AppConfig::getString(const std::string& key, std::string_view defaul
     return val ? std::string(val) : std::string(default_value);
 }
 
+std::expected<bool, std::string> AppConfig::getBool(const std::string& key, bool default_value) const {
+    const char* val = std::getenv(key.c_str());
+    if (!val || !*val) return default_value;
+
+    std::string value(val);
+    std::ranges::transform(value, value.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (value == "true" || value == "1" || value == "yes" || value == "on") return true;
+    if (value == "false" || value == "0" || value == "no" || value == "off") return false;
+    return std::unexpected(key + "='" + val + "' is not a boolean (true/false, 1/0, yes/no, on/off)");
+}
+
 int AppConfig::getInt(const std::string& key, int default_value) const {
     const char* val = std::getenv(key.c_str());
     if (!val) return default_value;
@@ -0,0 +1,250 @@
+/**
+ * SPDX-FileComment: CPU Affinity Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file cpu_affinity.cpp
+ * @brief Implementation of CpuAffinity.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/cpu_affinity.hpp"
+#include "utils/app_config.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace rz::utils {
+
+namespace {
+
+struct Layout {
+    bool enabled = false;
+    bool pin_io = true;
+    int node = -1;
+    CpuList io;
+    CpuList background;
+};
+
+Layout g_layout; // written once during startup
+
+cpu_set_t toCpuSet(const CpuList& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return set;
+}
+
+CpuList allowedCpus() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CpuList cpus;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::string formatList(const CpuList& cpus) {
+    std::string out;
+    for (std::size_t i = 0; i < cpus.size(); ++i) {
+        std::size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        if (!out.empty()) out += ",";
+        out += (j > i) ? std::format("{}-{}", cpus[i], cpus[j]) : std::to_string(cpus[i]);
+        i = j;
+    }
+    return out.empty() ? "-" : out;
+}
+
+void applyToThread(const CpuList& cpus) {
+    if (cpus.empty()) return;
+    cpu_set_t set = toCpuSet(cpus);
+    if (int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); rc != 0) {
+        spdlog::warn("CPU affinity: pthread_setaffinity_np failed ({})", rc);
+    }
+}
+
+} // namespace
+
+std::expected<CpuList, std::string> CpuAffinity::parseCpuList(std::string_view list) {
+    CpuList cpus;
+    while (!list.empty()) {
+        auto comma = list.find(',');
+        std::string_view item = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+        while (!item.empty() && (item.front() == ' ' || item.front() == '\n')) item.remove_prefix(1);
+        while (!item.empty() && (item.back() == ' ' || item.back() == '\n')) item.remove_suffix(1);
+        if (item.empty()) continue;
+
+        int first = 0;
+        int last = 0;
+        auto dash = item.find('-');
+        auto lo = item.substr(0, dash);
+        if (std::from_chars(lo.data(), lo.data() + lo.size(), first).ec != std::errc{}) {
+            return std::unexpected("Invalid CPU list entry: " + std::string(item));
+        }
+        last = first;
+        if (dash != std::string_view::npos) {
+            auto hi = item.substr(dash + 1);
+            if (std::from_chars(hi.data(), hi.data() + hi.size(), last).ec != std::errc{} || last < first) {
+                return std::unexpected("Invalid CPU range: " + std::string(item));
+            }
+        }
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::vector<CpuList> CpuAffinity::numaNodes() {
+    const CpuList allowed = allowedCpus();
+    std::vector<std::pair<int, CpuList>> nodes;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (!name.starts_with("node") || name.size() == 4) continue;
+        int id = 0;
+        if (std::from_chars(name.data() + 4, name.data() + name.size(), id).ec != std::errc{}) continue;
+
+        std::ifstream in(entry.path() / "cpulist");
+        std::string line;
+        std::getline(in, line);
+        auto cpus = parseCpuList(line);
+        if (!cpus) continue;
+
+        CpuList usable;
+        std::set_intersection(cpus->begin(), cpus->end(), allowed.begin(), allowed.end(), std::back_inserter(usable));
+        if (!usable.empty()) nodes.emplace_back(id, std::move(usable));
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    std::vector<CpuList> result;
+    for (auto& node : nodes) result.push_back(std::move(node.second));
+    if (result.empty() && !allowed.empty()) result.push_back(allowed); // no NUMA info: one node
+    return result;
+}
+
+std::expected<void, std::string> CpuAffinity::configure(int worker_index) {
+    auto& config = AppConfig::getInstance();
+    std::string mode = config.getString("CPU_AFFINITY", "off");
+    auto pin = config.getBool("CPU_AFFINITY_PIN_IO", true);
+    if (!pin) return std::unexpected(pin.error());
+
+    Layout layout;
+    layout.pin_io = *pin;
+
+    if (mode == "off" || mode.empty()) {
+        g_layout = layout;
+        return {};
+    }
+
+    if (mode == "manual") {
+        auto io = parseCpuList(config.getString("CPU_AFFINITY_IO", ""));
+        if (!io) return std::unexpected(io.error());
+        auto background = parseCpuList(config.getString("CPU_AFFINITY_BACKGROUND", ""));
+        if (!background) return std::unexpected(background.error());
+        layout.io = std::move(*io);
+        layout.background = std::move(*background);
+    } else if (mode == "numa") {
+        auto nodes = numaNodes();
+        if (nodes.empty()) return std::unexpected("No usable CPUs found");
+
+        int forced = config.getInt("CPU_NUMA_NODE", -1);
+        if (forced >= 0 || worker_index >= 0) {
+            // One node per process: keeps threads and their memory local
+            layout.node = (forced >= 0 ? forced : worker_index) % static_cast<int>(nodes.size());
+            layout.io = nodes[layout.node];
+        } else {
+            for (const auto& node : nodes) layout.io.insert(layout.io.end(), node.begin(), node.end());
+        }
+        // Reserve the last CPU of the (first) node for logging / probing threads
+        const CpuList& home = layout.node >= 0 ? nodes[layout.node] : nodes.front();
+        if (home.size() > 1) {
+            layout.background.push_back(home.back());
+            std::erase(layout.io, home.back());
+        } else {
+            layout.background = home;
+        }
+    } else {
+        return std::unexpected("Unknown CPU_AFFINITY mode: " + mode);
+    }
+
+    if (layout.io.empty()) return std::unexpected("CPU_AFFINITY: empty I/O CPU set");
+    layout.enabled = true;
+    g_layout = std::move(layout);
+    return {};
+}
+
+bool CpuAffinity::enabled() {
+    return g_layout.enabled;
+}
+
+const CpuList& CpuAffinity::ioCpus() {
+    return g_layout.io;
+}
+
+std::string CpuAffinity::describe() {
+    if (!g_layout.enabled) return "disabled";
+    return std::format("io={} background={}{}{}", formatList(g_layout.io), formatList(g_layout.background),
+                       g_layout.node >= 0 ? std::format(" numa_node={}", g_layout.node) : "",
+                       g_layout.pin_io ? " (io threads pinned)" : "");
+}
+
+void CpuAffinity::applyBackground() {
+    if (g_layout.enabled) applyToThread(g_layout.background);
+}
+
+void CpuAffinity::applyIo() {
+    if (g_layout.enabled) applyToThread(g_layout.io);
+}
+
+std::set<pid_t> CpuAffinity::threadIds() {
+    std::set<pid_t> tids;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+        std::string name = entry.path().filename().string();
+        pid_t tid = 0;
+        if (std::from_chars(name.data(), name.data() + name.size(), tid).ec == std::errc{}) tids.insert(tid);
+    }
+    return tids;
+}
+
+std::size_t CpuAffinity::pinNewIoThreads(const std::set<pid_t>& before) {
+    if (!g_layout.enabled || !g_layout.pin_io || g_layout.io.empty()) return 0;
+
+    std::size_t pinned = 0;
+    for (pid_t tid : threadIds()) {
+        if (before.contains(tid)) continue;
+        int cpu = g_layout.io[pinned % g_layout.io.size()];
+        cpu_set_t set = toCpuSet({cpu});
+        if (sched_setaffinity(tid, sizeof(set), &set) == 0) {
+            ++pinned;
+        } else {
+            spdlog::warn("CPU affinity: could not pin thread {} to CPU {}", tid, cpu);
+        }
+    }
+    return pinned;
+}
+
+} // namespace rz::utils
@@ -0,0 +1,139 @@
+/**
+ * SPDX-FileComment: HTTP Caching Helpers Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file http_cache.cpp
+ * @brief Implementation of HttpCache and CachedResponse.
+ * @version 0.1.3
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/http_cache.hpp"
+#include "utils/string_utils.hpp"
+#include <openssl/evp.h>
+#include <array>
+
+namespace rz::utils {
+
+namespace {
+
+constexpr std::size_t ETAG_DIGEST_BYTES = 16; // 128 bit is plenty for cache validation
+
+std::string_view stripWeak(std::string_view tag) {
+    if (tag.starts_with("W/")) tag.remove_prefix(2);
+    return tag;
+}
+
+// True if candidate is etag with a content-coding suffix ("abc" -> "abc-gzip"),
+// the ETag of a variant compressed by the CompressionMiddleware
+bool isCodedVariant(std::string_view candidate, std::string_view etag) {
+    if (etag.size() < 2 || candidate.size() <= etag.size() || !candidate.ends_with('"')) return false;
+    const std::string_view stem = etag.substr(0, etag.size() - 1);
+    if (!candidate.starts_with(stem)) return false;
+    const std::string_view suffix = candidate.substr(stem.size(), candidate.size() - stem.size() - 1);
+    return suffix == "-gzip" || suffix == "-deflate" || suffix == "-zstd" || suffix == "-br";
+}
+
+} // namespace
+
+std::string HttpCache::makeEtag(std::string_view content) {
+    std::array<unsigned char, EVP_MAX_MD_SIZE> digest{};
+    unsigned int len = 0;
+    EVP_Digest(content.data(), content.size(), digest.data(), &len, EVP_sha256(), nullptr);
+
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string etag;
+    etag.reserve(ETAG_DIGEST_BYTES * 2 + 2);
+    etag.push_back('"');
+    for (std::size_t i = 0; i < ETAG_DIGEST_BYTES && i < len; ++i) {
+        etag.push_back(HEX[digest[i] >> 4]);
+        etag.push_back(HEX[digest[i] & 0x0F]);
+    }
+    etag.push_back('"');
+    return etag;
+}
+
+bool HttpCache::ifNoneMatch(std::string_view header, std::string_view etag) {
+    header = StringUtils::trim(header);
+    if (header.empty() || etag.empty()) return false;
+    if (header == "*") return true;
+
+    const std::string_view current = stripWeak(etag);
+    while (!header.empty()) {
+        auto comma = header.find(',');
+        std::string_view candidate = StringUtils::trim(header.substr(0, comma));
+        candidate = stripWeak(candidate);
+        if (candidate == current || isCodedVariant(candidate, current)) return true;
+        if (comma == std::string_view::npos) break;
+        header.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+std::string HttpCache::httpDate(std::time_t t) {
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    char buf[32];
+    auto len = std::strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return std::string(buf, len);
+}
+
+bool HttpCache::notModifiedSince(std::string_view header, std::time_t last_modified) {
+    header = StringUtils::trim(header);
+    if (header.empty()) return false;
+
+    // Only the IMF-fixdate form is accepted; anything else is ignored as the RFC allows
+    std::tm tm{};
+    std::string value(header);
+    const char* end = strptime(value.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    if (!end || *end != '\0') return false;
+    return last_modified <= timegm(&tm);
+}
+
+bool HttpCache::acceptsEncoding(std::string_view header, std::string_view coding) {
+    while (!header.empty()) {
+        auto comma = header.find(',');
+        std::string_view item = StringUtils::trim(header.substr(0, comma));
+        auto semicolon = item.find(';');
+        std::string_view name = StringUtils::trim(item.substr(0, semicolon));
+        if (name == coding) {
+            if (semicolon == std::string_view::npos) return true;
+            std::string_view params = StringUtils::trim(item.substr(semicolon + 1));
+            return !(params.starts_with("q=0") && params.find_first_not_of("q=0.") == std::string_view::npos);
+        }
+        if (comma == std::string_view::npos) break;
+        header.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+CachedResponse::CachedResponse(std::string body, std::string content_type)
+    : m_body(std::move(body)),
+      m_contentType(std::move(content_type)),
+      m_etag(HttpCache::makeEtag(m_body)) {}
+
+crow::response CachedResponse::serve(const crow::request& req) const {
+    crow::response res;
+    res.set_header("ETag", m_etag);
+    res.set_header("Cache-Control", "no-cache");
+
+    if (HttpCache::ifNoneMatch(req.get_header_value("If-None-Match"), m_etag)) {
+        res.code = 304;
+        return res;
+    }
+
+    res.code = 200;
+    res.set_header("Content-Type", m_contentType);
+    res.body = m_body;
+    return res;
+}
+
+} // namespace rz::utils
@@ -0,0 +1,329 @@
+/**
+ * SPDX-FileComment: JSON Reader Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file json_reader.cpp
+ * @brief Implementation of parseJson() and JsonValue accessors.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/json_reader.hpp"
+#include <charconv>
+#include <format>
+#include <vector>
+
+namespace rz::utils {
+
+namespace {
+
+constexpr int MAX_DEPTH = 64;
+
+/**
+ * @brief Recursive-descent parser. Members of open containers are collected on
+ * a reused per-thread stack and copied into the arena in one piece when the
+ * container closes, so the arena only holds exactly sized arrays.
+ */
+class Parser {
+public:
+    Parser(std::string_view text, std::pmr::memory_resource* arena, std::vector<JsonMember>& stack)
+        : m_text(text), m_arena(arena), m_stack(stack) {}
+
+    std::expected<const JsonValue*, std::string> parseDocument() {
+        auto* root = static_cast<JsonValue*>(m_arena->allocate(sizeof(JsonValue), alignof(JsonValue)));
+        new (root) JsonValue{};
+        skipWhitespace();
+        if (!parseValue(*root, 0)) return std::unexpected(m_error);
+        skipWhitespace();
+        if (m_pos != m_text.size()) return std::unexpected(error("trailing characters"));
+        return root;
+    }
+
+private:
+    std::string error(std::string_view what) {
+        return std::format("Invalid JSON at offset {}: {}", m_pos, what);
+    }
+
+    bool fail(std::string_view what) {
+        m_error = error(what);
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+            ++m_pos;
+        }
+    }
+
+    bool consume(std::string_view literal) {
+        if (m_text.substr(m_pos, literal.size()) != literal) return false;
+        m_pos += literal.size();
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (m_pos >= m_text.size()) return fail("unexpected end");
+        switch (m_text[m_pos]) {
+            case '{': return parseContainer(out, depth, JsonValue::Type::Object, '}');
+            case '[': return parseContainer(out, depth, JsonValue::Type::Array, ']');
+            case '"':
+                out.type = JsonValue::Type::String;
+                return parseString(out.text);
+            case 't':
+                out.type = JsonValue::Type::Bool;
+                out.boolean = true;
+                return consume("true") || fail("invalid literal");
+            case 'f':
+                out.type = JsonValue::Type::Bool;
+                return consume("false") || fail("invalid literal");
+            case 'n':
+                out.type = JsonValue::Type::Null;
+                return consume("null") || fail("invalid literal");
+            default:
+                out.type = JsonValue::Type::Number;
+                return parseNumber(out.text);
+        }
+    }
+
+    bool parseContainer(JsonValue& out, int depth, JsonValue::Type type, char close) {
+        if (depth >= MAX_DEPTH) return fail("nesting too deep");
+        ++m_pos; // '{' or '['
+        out.type = type;
+        const std::size_t start = m_stack.size();
+
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == close) {
+            ++m_pos;
+            return true;
+        }
+
+        while (true) {
+            JsonMember member;
+            if (type == JsonValue::Type::Object) {
+                if (m_pos >= m_text.size() || m_text[m_pos] != '"') return fail("expected member name");
+                if (!parseString(member.key)) return false;
+                skipWhitespace();
+                if (m_pos >= m_text.size() || m_text[m_pos] != ':') return fail("expected ':'");
+                ++m_pos;
+                skipWhitespace();
+            }
+            if (!parseValue(member.value, depth + 1)) return false;
+            m_stack.push_back(member);
+
+            skipWhitespace();
+            if (m_pos >= m_text.size()) return fail("unexpected end");
+            if (m_text[m_pos] == ',') {
+                ++m_pos;
+                skipWhitespace();
+                continue;
+            }
+            if (m_text[m_pos] != close) return fail("expected ',' or closing bracket");
+            ++m_pos;
+            break;
+        }
+
+        out.count = m_stack.size() - start;
+        auto* members = static_cast<JsonMember*>(
+            m_arena->allocate(out.count * sizeof(JsonMember), alignof(JsonMember)));
+        for (std::size_t i = 0; i < out.count; ++i) {
+            new (members + i) JsonMember(m_stack[start + i]);
+        }
+        out.members = members;
+        m_stack.resize(start);
+        return true;
+    }
+
+    bool parseNumber(std::string_view& out) {
+        const std::size_t start = m_pos;
+        auto digits = [this] {
+            std::size_t first = m_pos;
+            while (m_pos < m_text.size() && m_text[m_pos] >= '0' && m_text[m_pos] <= '9') ++m_pos;
+            return m_pos - first;
+        };
+
+        if (m_pos < m_text.size() && m_text[m_pos] == '-') ++m_pos;
+        if (m_pos < m_text.size() && m_text[m_pos] == '0') {
+            ++m_pos;
+        } else if (digits() == 0) {
+            return fail("invalid value");
+        }
+        if (m_pos < m_text.size() && m_text[m_pos] == '.') {
+            ++m_pos;
+            if (digits() == 0) return fail("invalid number");
+        }
+        if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+            ++m_pos;
+            if (m_pos < m_text.size() && (m_text[m_pos] == '+' || m_text[m_pos] == '-')) ++m_pos;
+            if (digits() == 0) return fail("invalid number");
+        }
+        out = m_text.substr(start, m_pos - start);
+        return true;
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool parseHex4(std::uint32_t& out) {
+        if (m_pos + 4 > m_text.size()) return fail("truncated \\u escape");
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            int v = hexValue(m_text[m_pos++]);
+            if (v < 0) return fail("invalid \\u escape");
+            out = (out << 4) | static_cast<std::uint32_t>(v);
+        }
+        return true;
+    }
+
+    bool parseString(std::string_view& out) {
+        const std::size_t start = ++m_pos; // After the opening quote
+        bool escaped = false;
+        while (true) {
+            if (m_pos >= m_text.size()) return fail("unterminated string");
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') break;
+            if (c < 0x20) return fail("control character in string");
+            if (c == '\\') {
+                escaped = true;
+                if (++m_pos >= m_text.size()) return fail("unterminated string");
+            }
+            ++m_pos;
+        }
+        const std::string_view raw = m_text.substr(start, m_pos - start);
+        ++m_pos; // Closing quote
+
+        if (!escaped) {
+            out = raw; // The common case: a view into the body
+            return true;
+        }
+
+        // Decoded text is never longer than the escaped one
+        auto* buffer = static_cast<char*>(m_arena->allocate(raw.size(), 1));
+        std::size_t length = 0;
+        const std::size_t end = m_pos - 1;
+        m_pos = start;
+        while (m_pos < end) {
+            char c = m_text[m_pos++];
+            if (c != '\\') {
+                buffer[length++] = c;
+                continue;
+            }
+            switch (m_text[m_pos++]) {
+                case '"': buffer[length++] = '"'; break;
+                case '\\': buffer[length++] = '\\'; break;
+                case '/': buffer[length++] = '/'; break;
+                case 'b': buffer[length++] = '\b'; break;
+                case 'f': buffer[length++] = '\f'; break;
+                case 'n': buffer[length++] = '\n'; break;
+                case 'r': buffer[length++] = '\r'; break;
+                case 't': buffer[length++] = '\t'; break;
+                case 'u': {
+                    std::uint32_t code;
+                    if (!parseHex4(code)) return false;
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        std::uint32_t low;
+                        if (m_text.substr(m_pos, 2) != "\\u") return fail("unpaired surrogate");
+                        m_pos += 2;
+                        if (!parseHex4(low)) return false;
+                        if (low < 0xDC00 || low > 0xDFFF) return fail("unpaired surrogate");
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                        return fail("unpaired surrogate");
+                    }
+                    // UTF-8 encoding fits: a 6 byte escape yields <= 3 bytes, a 12 byte pair 4 bytes
+                    if (code < 0x80) {
+                        buffer[length++] = static_cast<char>(code);
+                    } else if (code < 0x800) {
+                        buffer[length++] = static_cast<char>(0xC0 | (code >> 6));
+                        buffer[length++] = static_cast<char>(0x80 | (code & 0x3F));
+                    } else if (code < 0x10000) {
+                        buffer[length++] = static_cast<char>(0xE0 | (code >> 12));
+                        buffer[length++] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                        buffer[length++] = static_cast<char>(0x80 | (code & 0x3F));
+                    } else {
+                        buffer[length++] = static_cast<char>(0xF0 | (code >> 18));
+                        buffer[length++] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                        buffer[length++] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                        buffer[length++] = static_cast<char>(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default:
+                    --m_pos;
+                    return fail("invalid escape");
+            }
+        }
+        ++m_pos; // Closing quote
+        out = std::string_view(buffer, length);
+        return true;
+    }
+
+    std::string_view m_text;
+    std::pmr::memory_resource* m_arena;
+    std::vector<JsonMember>& m_stack;
+    std::size_t m_pos = 0;
+    std::string m_error;
+};
+
+} // namespace
+
+std::optional<std::string_view> JsonValue::asString() const {
+    if (type != Type::String) return std::nullopt;
+    return text;
+}
+
+std::optional<std::int64_t> JsonValue::asInt() const {
+    if (type != Type::Number) return std::nullopt;
+    std::int64_t value;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) return std::nullopt; // Fraction or overflow
+    return value;
+}
+
+std::optional<double> JsonValue::asDouble() const {
+    if (type != Type::Number) return std::nullopt;
+    double value;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{}) return std::nullopt;
+    return value;
+}
+
+std::optional<bool> JsonValue::asBool() const {
+    if (type != Type::Bool) return std::nullopt;
+    return boolean;
+}
+
+const JsonValue* JsonValue::find(std::string_view key) const {
+    if (type != Type::Object) return nullptr;
+    for (const auto& member : *this) {
+        if (member.key == key) return &member.value;
+    }
+    return nullptr;
+}
+
+const JsonValue* JsonValue::at(std::size_t index) const {
+    if (type != Type::Array || index >= count) return nullptr;
+    return &members[index].value;
+}
+
+std::expected<const JsonValue*, std::string> parseJson(std::string_view text, std::pmr::memory_resource* arena) {
+    // Scratch stack of open containers; keeps its capacity across requests
+    thread_local std::vector<JsonMember> stack;
+    stack.clear();
+    return Parser(text, arena, stack).parseDocument();
+}
+
+} // namespace rz::utils
@@ -0,0 +1,173 @@
+/**
+ * SPDX-FileComment: JSON Writer Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file json_writer.cpp
+ * @brief Implementation of JsonWriter.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/json_writer.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace rz::utils {
+
+namespace {
+
+constexpr std::uint64_t ONES = 0x0101010101010101ull;
+constexpr std::uint64_t HIGHS = 0x8080808080808080ull;
+
+// Non-zero if any byte of the word is a control character, '"' or '\\' (SWAR)
+constexpr std::uint64_t needsEscape(std::uint64_t word) {
+    const std::uint64_t control = (word - ONES * 0x20) & ~word;
+    const std::uint64_t quote = word ^ (ONES * '"');
+    const std::uint64_t backslash = word ^ (ONES * '\\');
+    return (control | ((quote - ONES) & ~quote) | ((backslash - ONES) & ~backslash)) & HIGHS;
+}
+
+constexpr bool needsEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+void appendEscape(std::string& out, unsigned char c) {
+    switch (c) {
+        case '"': out.append("\\\""); return;
+        case '\\': out.append("\\\\"); return;
+        case '\b': out.append("\\b"); return;
+        case '\f': out.append("\\f"); return;
+        case '\n': out.append("\\n"); return;
+        case '\r': out.append("\\r"); return;
+        case '\t': out.append("\\t"); return;
+        default: {
+            static constexpr char HEX[] = "0123456789abcdef";
+            const char escaped[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+            out.append(escaped, sizeof(escaped));
+        }
+    }
+}
+
+} // namespace
+
+void JsonWriter::appendEscaped(std::string& out, std::string_view text) {
+    out.push_back('"');
+    const char* data = text.data();
+    const std::size_t size = text.size();
+    std::size_t run = 0; // Start of the pending unescaped run
+    std::size_t i = 0;
+
+    while (i < size) {
+        // Skip clean 8-byte words; only words with a hit are inspected bytewise
+        if (i + 8 <= size) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            if (!needsEscape(word)) {
+                i += 8;
+                continue;
+            }
+        }
+        const std::size_t end = i + 8 < size ? i + 8 : size;
+        for (; i < end; ++i) {
+            const auto c = static_cast<unsigned char>(data[i]);
+            if (needsEscape(c)) {
+                out.append(data + run, i - run);
+                appendEscape(out, c);
+                run = i + 1;
+            }
+        }
+    }
+    out.append(data + run, size - run);
+    out.push_back('"');
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    appendEscaped(*m_out, name);
+    m_out->push_back(':');
+    m_needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    separate();
+    appendEscaped(*m_out, text);
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    m_out->append(flag ? "true" : "false");
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::nullptr_t) {
+    separate();
+    m_out->append("null");
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::int64_t number) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    m_out->append(buffer, result.ptr);
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::uint64_t number) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    m_out->append(buffer, result.ptr);
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) {
+        return value(nullptr);
+    }
+    separate();
+    char buffer[32];
+    // Shortest representation that round-trips, like nlohmann's dump()
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    m_out->append(buffer, result.ptr);
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(std::string_view json) {
+    separate();
+    m_out->append(json);
+    m_needComma = true;
+    return *this;
+}
+
+std::string JsonWriter::take() {
+    std::string result = std::move(*m_out);
+    m_out->clear();
+    m_needComma = false;
+    return result;
+}
+
+crow::response JsonWriter::response(int code) {
+    crow::response res(code, take());
+    res.set_header("Content-Type", "application/json");
+    return res;
+}
+
+} // namespace rz::utils
@@ -0,0 +1,109 @@
+/**
+ * SPDX-FileComment: Logging Setup Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file logging_utils.cpp
+ * @brief Implementation of LoggingUtils.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/logging_utils.hpp"
+#include "utils/app_config.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/memory_accounting.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <algorithm>
+#include <format>
+
+namespace rz::utils {
+
+LoggingOptions LoggingUtils::optionsFromConfig(const std::string& log_file) {
+    auto& config = AppConfig::getInstance();
+
+    LoggingOptions options;
+    options.file = log_file;
+    options.level = config.getString("LOG_LEVEL", "info");
+
+    // Logging is not set up yet; the default console logger reports a bad value
+    auto async = config.getBool("LOG_ASYNC", false);
+    if (!async) spdlog::warn("{}", async.error());
+    options.async = async.value_or(false);
+    options.queue_size = static_cast<std::size_t>(std::max(128, config.getInt("LOG_ASYNC_QUEUE_SIZE", 8192)));
+    options.drop_oldest = config.getString("LOG_ASYNC_OVERFLOW", "block") == "drop_oldest";
+    options.flush_interval_sec = std::max(1, config.getInt("LOG_FLUSH_INTERVAL_SEC", 3));
+    return options;
+}
+
+std::expected<void, std::string> LoggingUtils::init(const LoggingOptions& options) {
+    try {
+        auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(options.file, 1024 * 1024 * 5, 3);
+        std::vector<spdlog::sink_ptr> sinks {console_sink, file_sink};
+
+        std::shared_ptr<spdlog::logger> logger;
+        if (options.async) {
+            // Ring buffer is allocated once; a single worker thread formats and writes
+            spdlog::init_thread_pool(options.queue_size, 1);
+            MemoryAccounting::getInstance().account("log_queue").set(options.queue_size *
+                                                                     sizeof(spdlog::details::async_msg));
+            logger = std::make_shared<spdlog::async_logger>(
+                "multi_sink", sinks.begin(), sinks.end(), spdlog::thread_pool(),
+                options.drop_oldest ? spdlog::async_overflow_policy::overrun_oldest
+                                    : spdlog::async_overflow_policy::block);
+
+            rz::services::MetricsService::getInstance().addCollector([](std::string& out) {
+                auto pool = spdlog::thread_pool();
+                out += "# HELP rz_log_dropped_messages_total Log messages dropped because the async queue was full.\n"
+                       "# TYPE rz_log_dropped_messages_total counter\n";
+                out += std::format("rz_log_dropped_messages_total {}\n", droppedMessages());
+                out += "# HELP rz_log_queue_depth Messages waiting in the async log queue.\n"
+                       "# TYPE rz_log_queue_depth gauge\n";
+                out += std::format("rz_log_queue_depth {}\n", pool ? pool->queue_size() : 0);
+            });
+        } else {
+            logger = std::make_shared<spdlog::logger>("multi_sink", sinks.begin(), sinks.end());
+        }
+
+        logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+        spdlog::set_default_logger(logger);
+
+        if (options.level == "debug") spdlog::set_level(spdlog::level::debug);
+        else if (options.level == "warn") spdlog::set_level(spdlog::level::warn);
+        else if (options.level == "error") spdlog::set_level(spdlog::level::err);
+        else spdlog::set_level(spdlog::level::info);
+
+        // Flush on Error AND periodically
+        spdlog::flush_on(spdlog::level::err);
+        spdlog::flush_every(std::chrono::seconds(options.flush_interval_sec));
+
+    } catch (const spdlog::spdlog_ex& ex) {
+        return std::unexpected(std::string("Log initialization failed: ") + ex.what());
+    }
+    return {};
+}
+
+std::uint64_t LoggingUtils::droppedMessages() {
+    auto pool = spdlog::thread_pool();
+    return pool ? static_cast<std::uint64_t>(pool->overrun_counter()) : 0;
+}
+
+void LoggingUtils::shutdown() {
+    if (auto dropped = droppedMessages(); dropped > 0) {
+        spdlog::warn("Async logger dropped {} messages", dropped);
+    }
+    spdlog::shutdown();
+}
+
+} // namespace rz::utils
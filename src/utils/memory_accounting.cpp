@@ -0,0 +1,242 @@
+/**
+ * SPDX-FileComment: Memory Accounting Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file memory_accounting.cpp
+ * @brief Implementation of MemoryAccounting.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/memory_accounting.hpp"
+#include "utils/allocator_stats.hpp"
+#include "utils/app_config.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/json_writer.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace rz::utils {
+
+namespace {
+
+bool parseBytes(std::string_view text, std::size_t& bytes) {
+    text = StringUtils::trim(text);
+    return std::from_chars(text.data(), text.data() + text.size(), bytes).ec == std::errc{};
+}
+
+} // namespace
+
+MemoryAccounting& MemoryAccounting::getInstance() {
+    static MemoryAccounting instance;
+    return instance;
+}
+
+MemoryAccounting::MemoryAccounting() {
+    rz::services::MetricsService::getInstance().addCollector([this](std::string& out) {
+        auto list = entries();
+        out += "# HELP rz_memory_bytes Memory held by a subsystem.\n"
+               "# TYPE rz_memory_bytes gauge\n";
+        std::string peaks = "# HELP rz_memory_peak_bytes Highest memory held by a subsystem since start.\n"
+                            "# TYPE rz_memory_peak_bytes gauge\n";
+        for (const auto* entry : list) {
+            auto usage = entry->probe();
+            out += std::format("rz_memory_bytes{{account=\"{}\"}} {}\n", entry->name, usage.current);
+            peaks += std::format("rz_memory_peak_bytes{{account=\"{}\"}} {}\n", entry->name, usage.peak);
+        }
+        out += peaks;
+
+        std::shared_lock lock(m_mutex);
+        if (m_limits.empty() && m_softLimit == 0) return;
+        out += "# HELP rz_memory_limit_bytes Soft memory limit of a subsystem (account=\"total\": all of them).\n"
+               "# TYPE rz_memory_limit_bytes gauge\n";
+        for (const auto& [name, limit] : m_limits) {
+            out += std::format("rz_memory_limit_bytes{{account=\"{}\"}} {}\n", name, limit);
+        }
+        if (m_softLimit > 0) out += std::format("rz_memory_limit_bytes{{account=\"total\"}} {}\n", m_softLimit);
+    });
+}
+
+MemoryAccounting::~MemoryAccounting() {
+    stop();
+}
+
+MemoryAccounting::Entry& MemoryAccounting::addEntry(std::string_view name, Probe probe, Shrink shrink) {
+    auto series = rz::services::MetricsService::getInstance().registerCounter(
+        "rz_memory_shrinks_total", "Shrink requests sent to a subsystem over its soft limit.",
+        std::format("account=\"{}\"", name));
+    return m_entries.emplace_back(Entry{std::string(name), std::move(probe), std::move(shrink), series});
+}
+
+MemoryAccount& MemoryAccounting::account(std::string_view name, Shrink shrink) {
+    std::unique_lock lock(m_mutex);
+    if (auto it = m_accountIndex.find(std::string(name)); it != m_accountIndex.end()) return *it->second;
+
+    MemoryAccount& counter = m_accounts.emplace_back();
+    m_accountIndex.emplace(std::string(name), &counter);
+    addEntry(name, [&counter] { return Usage{counter.current(), counter.peak()}; }, std::move(shrink));
+    return counter;
+}
+
+void MemoryAccounting::addProbe(std::string_view name, Probe probe, Shrink shrink) {
+    std::unique_lock lock(m_mutex);
+    addEntry(name, std::move(probe), std::move(shrink));
+}
+
+std::vector<const MemoryAccounting::Entry*> MemoryAccounting::entries() const {
+    std::shared_lock lock(m_mutex);
+    std::vector<const Entry*> list;
+    list.reserve(m_entries.size());
+    for (const auto& entry : m_entries) list.push_back(&entry);
+    return list;
+}
+
+void MemoryAccounting::configure() {
+    auto& config = AppConfig::getInstance();
+    {
+        std::unique_lock lock(m_mutex);
+        m_limits.clear();
+        std::string limits = config.getString("MEMORY_LIMITS", "");
+        for (std::string_view entry : StringUtils::splitList(limits)) {
+            auto key_value = StringUtils::splitKeyValue(entry);
+            std::size_t bytes = 0;
+            if (!key_value || !parseBytes(key_value->second, bytes)) {
+                spdlog::warn("MEMORY_LIMITS: invalid entry '{}'", entry);
+                continue;
+            }
+            m_limits[std::string(key_value->first)] = bytes;
+        }
+
+        m_softLimit = 0;
+        std::string soft_limit = config.getString("MEMORY_SOFT_LIMIT_BYTES", "0");
+        if (!parseBytes(soft_limit, m_softLimit)) {
+            spdlog::warn("MEMORY_SOFT_LIMIT_BYTES: invalid value '{}'", soft_limit);
+        }
+        m_interval = std::chrono::seconds(std::max(1, config.getInt("MEMORY_CHECK_INTERVAL_SEC", 5)));
+        if (m_limits.empty() && m_softLimit == 0) return;
+    }
+
+    if (m_thread.joinable()) return;
+    m_thread = std::jthread([this](std::stop_token token) { run(token); });
+    spdlog::info("Memory accounting: {} account limits, total limit {} KiB, checked every {} s", m_limits.size(),
+                 m_softLimit / 1024, m_interval.count());
+}
+
+void MemoryAccounting::stop() {
+    if (!m_thread.joinable()) return;
+    m_thread.request_stop();
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+std::size_t MemoryAccounting::limit(std::string_view name) const {
+    std::shared_lock lock(m_mutex);
+    auto it = m_limits.find(std::string(name));
+    return it == m_limits.end() ? 0 : it->second;
+}
+
+void MemoryAccounting::run(std::stop_token token) {
+    while (!token.stop_requested()) {
+        std::unique_lock lock(m_waitMutex);
+        m_cv.wait_for(lock, token, m_interval, [] { return false; });
+        lock.unlock();
+        if (!token.stop_requested()) enforce();
+    }
+}
+
+std::size_t MemoryAccounting::shrink(const Entry& entry, std::size_t current, std::size_t target,
+                                     std::string_view reason) {
+    rz::services::MetricsService::getInstance().increment(entry.shrinkSeries);
+    std::size_t released = entry.shrink(target);
+    spdlog::info("Memory: {} over {} ({} KiB), shrunk to {} KiB, released {} KiB", entry.name, reason,
+                 current / 1024, target / 1024, released / 1024);
+    return released;
+}
+
+std::size_t MemoryAccounting::enforce() {
+    // Shrink callbacks take the subsystems' own locks; no registry lock is held while they run
+    std::lock_guard guard(m_enforceMutex);
+    auto list = entries();
+    std::size_t soft_limit;
+    std::unordered_map<std::string, std::size_t> limits;
+    {
+        std::shared_lock lock(m_mutex);
+        soft_limit = m_softLimit;
+        limits = m_limits;
+    }
+
+    std::size_t released = 0;
+    std::size_t total = 0;
+    std::vector<std::pair<std::size_t, const Entry*>> shrinkable;
+    for (const auto* entry : list) {
+        std::size_t current = entry->probe().current;
+        if (auto it = limits.find(entry->name); it != limits.end() && current > it->second && entry->shrink) {
+            std::size_t freed = shrink(*entry, current, it->second, "its limit");
+            released += freed;
+            current -= std::min(current, freed);
+        }
+        total += current;
+        if (entry->shrink && current > 0) shrinkable.emplace_back(current, entry);
+    }
+
+    if (soft_limit == 0 || total <= soft_limit) return released;
+
+    // The excess comes from the largest caches first
+    std::size_t excess = total - soft_limit;
+    std::sort(shrinkable.begin(), shrinkable.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (const auto& [current, entry] : shrinkable) {
+        if (excess == 0) break;
+        std::size_t freed = shrink(*entry, current, current - std::min(current, excess), "the total limit");
+        released += freed;
+        excess -= std::min(excess, freed);
+    }
+    if (excess > 0) spdlog::warn("Memory: {} KiB over the total limit after shrinking", excess / 1024);
+    return released;
+}
+
+std::string MemoryAccounting::toJson() const {
+    auto list = entries();
+    std::unordered_map<std::string, std::size_t> limits;
+    std::size_t soft_limit;
+    {
+        std::shared_lock lock(m_mutex);
+        limits = m_limits;
+        soft_limit = m_softLimit;
+    }
+
+    JsonWriter json(256 + list.size() * 128);
+    std::size_t total = 0;
+    json.beginObject().key<"accounts">().beginArray();
+    for (const auto* entry : list) {
+        auto usage = entry->probe();
+        total += usage.current;
+        json.beginObject()
+            .field<"name">(entry->name)
+            .field<"current_bytes">(usage.current)
+            .field<"peak_bytes">(usage.peak)
+            .field<"shrinkable">(static_cast<bool>(entry->shrink));
+        if (auto it = limits.find(entry->name); it != limits.end()) json.field<"limit_bytes">(it->second);
+        json.endObject();
+    }
+    // What no account covers: code, stacks, the allocator's own overhead and unaccounted heap use
+    std::size_t resident = AllocatorStats::getInstance().snapshot(false).resident_bytes;
+    json.endArray()
+        .field<"total_bytes">(total)
+        .field<"soft_limit_bytes">(soft_limit)
+        .field<"resident_bytes">(resident)
+        .field<"unaccounted_bytes">(resident > total ? resident - total : 0)
+        .endObject();
+    return json.take();
+}
+
+} // namespace rz::utils
@@ -0,0 +1,42 @@
+/**
+ * SPDX-FileComment: Middleware Setup Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file middleware_setup.cpp
+ * @brief Implementation of MiddlewareSetup.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/middleware_setup.hpp"
+#include "services/compression_service.hpp"
+#include "utils/admission_controller.hpp"
+#include "utils/rate_limiter.hpp"
+#include "utils/request_arena.hpp"
+#include <spdlog/spdlog.h>
+
+namespace rz::utils {
+
+void MiddlewareSetup::configure() {
+    RequestArena::configure();
+    rz::services::CompressionService::getInstance().configure();
+}
+
+void MiddlewareSetup::configurePolicies() {
+    if (auto res = RateLimiter::getInstance().configure(); !res) {
+        spdlog::error("Rate limit configuration: {}", res.error());
+    }
+    if (auto res = AdmissionController::getInstance().configure(); !res) {
+        spdlog::error("Admission control configuration: {}", res.error());
+    }
+}
+
+} // namespace rz::utils
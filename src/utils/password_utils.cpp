@@ -2,7 +2,7 @@
  * @file password_utils.cpp
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @brief Password Hashing Utilities
- * @version 0.16.0
+ * @version 0.16.1
  * @date 2026-01-31
  *
  * @copyright Copyright (c) 2026 ZHENG Robert
@@ -17,6 +17,8 @@
 
 #include "utils/password_utils.hpp"
 #include "argon2.h"
+#include "utils/memory_accounting.hpp"
+#include <cstdlib>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -33,6 +35,40 @@ const uint32_t HASH_LEN = 32;   // 32 Bytes Output Hash
 namespace rz {
 namespace utils {
 
+namespace {
+
+/**
+ * @brief Charges the Argon2 scratch memory (m_cost KiB per running hash) to the "argon2" account.
+ */
+class ScratchCharge {
+public:
+  explicit ScratchCharge(std::size_t kib) : m_bytes(kib * 1024) {
+    account().add(m_bytes);
+  }
+  ~ScratchCharge() { account().sub(m_bytes); }
+  ScratchCharge(const ScratchCharge &) = delete;
+  ScratchCharge &operator=(const ScratchCharge &) = delete;
+
+private:
+  static MemoryAccount &account() {
+    static MemoryAccount &argon2 =
+        MemoryAccounting::getInstance().account("argon2");
+    return argon2;
+  }
+
+  std::size_t m_bytes;
+};
+
+// Memory cost of an encoded hash ("$argon2id$v=19$m=65536,t=3,p=4$...")
+std::size_t encodedMemoryCost(const std::string &encodedHash) {
+  auto pos = encodedHash.find("$m=");
+  if (pos == std::string::npos)
+    return M_COST;
+  return std::strtoull(encodedHash.c_str() + pos + 3, nullptr, 10);
+}
+
+} // namespace
+
 /**
  * @brief Hashes a plain text password using Argon2id.
  *
@@ -56,6 +92,7 @@ std::string PasswordUtils::hashPassword(const std::string &plainText) {
                                         HASH_LEN, Argon2_id);
   std::vector<char> encoded(encodedLen);
 
+  ScratchCharge scratch(M_COST);
   int result = argon2id_hash_encoded(
       T_COST, M_COST, PARALLELISM, plainText.c_str(), plainText.length(), salt,
       SALT_LEN, HASH_LEN, encoded.data(), encodedLen);
@@ -80,6 +117,7 @@ bool PasswordUtils::verifyPassword(const std::string &plainText,
   if (encodedHash.empty())
     return false;
 
+  ScratchCharge scratch(encodedMemoryCost(encodedHash));
   int result =
       argon2id_verify(encodedHash.c_str(), plainText.c_str(), plainText.length());
 
@@ -0,0 +1,221 @@
+/**
+ * SPDX-FileComment: Prefork Supervisor Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file prefork_supervisor.cpp
+ * @brief Implementation of PreforkSupervisor.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/prefork_supervisor.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace rz::utils {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A worker dying faster than this after start counts as a crash loop
+constexpr auto FAST_FAILURE_WINDOW = std::chrono::seconds(5);
+constexpr auto MAX_BACKOFF = std::chrono::seconds(30);
+constexpr auto READY_TIMEOUT = std::chrono::seconds(30);
+constexpr auto STOP_TIMEOUT = std::chrono::seconds(10);
+
+sigset_t supervisorSignals() {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    sigaddset(&set, SIGHUP);
+    sigaddset(&set, SIGTERM);
+    sigaddset(&set, SIGINT);
+    return set;
+}
+
+// Waits for pid to exit, escalating to SIGKILL after the timeout
+void waitOrKill(pid_t pid, std::chrono::seconds timeout) {
+    auto deadline = Clock::now() + timeout;
+    while (Clock::now() < deadline) {
+        pid_t rc = ::waitpid(pid, nullptr, WNOHANG);
+        if (rc == pid || (rc < 0 && errno == ECHILD)) return;
+        ::usleep(50'000);
+    }
+    spdlog::warn("Prefork: worker {} did not stop in time, killing it", pid);
+    ::kill(pid, SIGKILL);
+    ::waitpid(pid, nullptr, 0);
+}
+
+} // namespace
+
+PreforkSupervisor::PreforkSupervisor(unsigned workers)
+    : m_workers(std::max(1u, workers)), m_slots(m_workers) {}
+
+void PreforkSupervisor::notifyReady(int ready_fd) {
+    if (ready_fd < 0) return;
+    const char byte = '1';
+    [[maybe_unused]] auto rc = ::write(ready_fd, &byte, 1);
+    ::close(ready_fd);
+}
+
+pid_t PreforkSupervisor::spawn(unsigned index, const WorkerFn& worker) {
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) {
+        spdlog::error("Prefork: pipe failed: {}", std::strerror(errno));
+        return -1;
+    }
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        spdlog::error("Prefork: fork failed: {}", std::strerror(errno));
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return -1;
+    }
+
+    if (pid == 0) {
+        // Worker: die with the supervisor, restore default signal handling
+        ::close(fds[0]);
+        ::prctl(PR_SET_PDEATHSIG, SIGTERM);
+        sigset_t set = supervisorSignals();
+        ::sigprocmask(SIG_UNBLOCK, &set, nullptr);
+        ::setenv("RZ_WORKER_INDEX", std::to_string(index).c_str(), 1);
+        std::exit(worker(index, fds[1]));
+    }
+
+    ::close(fds[1]);
+    Slot& slot = m_slots[index];
+    if (slot.ready_fd >= 0) ::close(slot.ready_fd);
+    slot.pid = pid;
+    slot.ready_fd = fds[0];
+    slot.started = Clock::now();
+    spdlog::info("Prefork: worker {} started (pid {})", index, pid);
+    return pid;
+}
+
+bool PreforkSupervisor::waitReady(Slot& slot, std::chrono::seconds timeout) {
+    if (slot.ready_fd < 0) return false;
+    pollfd pfd{slot.ready_fd, POLLIN, 0};
+    int rc = ::poll(&pfd, 1, static_cast<int>(std::chrono::milliseconds(timeout).count()));
+    char byte = 0;
+    bool ready = rc > 0 && ::read(slot.ready_fd, &byte, 1) == 1;
+    ::close(slot.ready_fd);
+    slot.ready_fd = -1;
+    return ready;
+}
+
+void PreforkSupervisor::reap() {
+    int status = 0;
+    pid_t pid;
+    while ((pid = ::waitpid(-1, &status, WNOHANG)) > 0) {
+        auto it = std::find_if(m_slots.begin(), m_slots.end(), [pid](const Slot& s) { return s.pid == pid; });
+        if (it == m_slots.end()) continue; // retired during a rollover
+
+        std::string reason = WIFSIGNALED(status) ? "signal " + std::to_string(WTERMSIG(status))
+                                                 : "exit code " + std::to_string(WEXITSTATUS(status));
+        auto now = Clock::now();
+        it->fast_failures = (now - it->started < FAST_FAILURE_WINDOW) ? it->fast_failures + 1 : 0;
+        auto backoff = std::min<Clock::duration>(std::chrono::seconds(1) * (1u << std::min(it->fast_failures, 5u)), MAX_BACKOFF);
+        if (it->fast_failures == 0) backoff = Clock::duration::zero();
+
+        spdlog::warn("Prefork: worker {} (pid {}) exited with {}, restarting in {} ms",
+                     std::distance(m_slots.begin(), it), pid, reason,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(backoff).count());
+        it->pid = -1;
+        it->restart_at = now + backoff;
+    }
+}
+
+void PreforkSupervisor::rollingRestart(const WorkerFn& worker) {
+    spdlog::info("Prefork: SIGHUP received, rolling over {} workers", m_workers);
+    for (unsigned i = 0; i < m_workers; ++i) {
+        pid_t old_pid = m_slots[i].pid;
+        // Old and new worker share the port via SO_REUSEPORT while overlapping; the new one
+        // takes over the Unix socket path by renaming its own socket over it
+        if (spawn(i, worker) < 0) continue;
+        if (!waitReady(m_slots[i], READY_TIMEOUT)) {
+            spdlog::error("Prefork: replacement worker {} did not become ready, keeping the old one", i);
+            ::kill(m_slots[i].pid, SIGKILL);
+            ::waitpid(m_slots[i].pid, nullptr, 0);
+            m_slots[i].pid = old_pid;
+            continue;
+        }
+        if (old_pid > 0) {
+            ::kill(old_pid, SIGTERM);
+            waitOrKill(old_pid, STOP_TIMEOUT);
+        }
+    }
+    spdlog::info("Prefork: rollover complete");
+}
+
+void PreforkSupervisor::stopAll() {
+    for (auto& slot : m_slots) {
+        if (slot.pid > 0) ::kill(slot.pid, SIGTERM);
+    }
+    for (auto& slot : m_slots) {
+        if (slot.pid > 0) waitOrKill(slot.pid, STOP_TIMEOUT);
+        slot.pid = -1;
+        if (slot.ready_fd >= 0) ::close(slot.ready_fd);
+        slot.ready_fd = -1;
+    }
+}
+
+int PreforkSupervisor::run(const WorkerFn& worker) {
+    // Tell the (patched) Crow acceptor to set SO_REUSEPORT in every worker
+    ::setenv("RZ_SO_REUSEPORT", "1", 1);
+
+    sigset_t signals = supervisorSignals();
+    ::sigprocmask(SIG_BLOCK, &signals, nullptr);
+
+    spdlog::info("Prefork: supervisor {} starting {} workers", ::getpid(), m_workers);
+    for (unsigned i = 0; i < m_workers; ++i) {
+        spawn(i, worker);
+    }
+
+    while (true) {
+        timespec tick{1, 0};
+        siginfo_t info{};
+        int sig = ::sigtimedwait(&signals, &info, &tick);
+
+        if (sig == SIGTERM || sig == SIGINT) {
+            spdlog::info("Prefork: signal {} received, stopping workers", sig);
+            stopAll();
+            return 0;
+        }
+        if (sig == SIGHUP) {
+            reap();
+            rollingRestart(worker);
+        }
+        reap();
+
+        // (Re)start empty slots whose backoff has expired
+        auto now = Clock::now();
+        for (unsigned i = 0; i < m_workers; ++i) {
+            if (m_slots[i].pid < 0 && now >= m_slots[i].restart_at) {
+                spawn(i, worker);
+            }
+        }
+    }
+}
+
+} // namespace rz::utils
@@ -0,0 +1,252 @@
+/**
+ * SPDX-FileComment: Rate Limiter Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file rate_limiter.cpp
+ * @brief Implementation of RateLimiter.
+ * @version 0.1.3
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/rate_limiter.hpp"
+#include "utils/app_config.hpp"
+#include "utils/string_utils.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <format>
+
+namespace rz::utils {
+
+namespace {
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool parseNumber(std::string_view s, int& out) {
+    s = StringUtils::trim(s);
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc{} && ptr == s.data() + s.size() && out > 0;
+}
+
+// "<requests>/<seconds>[:<burst>]", e.g. "5/60" or "100/1:200"
+bool parseLimit(std::string_view spec, double& rate, double& burst) {
+    auto slash = spec.find('/');
+    if (slash == std::string_view::npos) return false;
+    auto colon = spec.find(':', slash);
+
+    int requests = 0, seconds = 0, capacity = 0;
+    if (!parseNumber(spec.substr(0, slash), requests)) return false;
+    if (!parseNumber(spec.substr(slash + 1, colon == std::string_view::npos ? colon : colon - slash - 1), seconds)) {
+        return false;
+    }
+    if (colon != std::string_view::npos) {
+        if (!parseNumber(spec.substr(colon + 1), capacity)) return false;
+    } else {
+        capacity = requests;
+    }
+    rate = static_cast<double>(requests) / seconds;
+    burst = capacity;
+    return true;
+}
+
+// FNV-1a, spreads the keys over shards (high bits) and map buckets (low bits)
+std::uint64_t hashKey(std::size_t policy, char kind, std::string_view identity) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+    for (std::size_t i = 0; i < sizeof(policy); ++i) mix(static_cast<unsigned char>(policy >> (i * 8)));
+    mix(static_cast<unsigned char>(kind));
+    for (char c : identity) mix(static_cast<unsigned char>(c));
+    return hash ^ (hash >> 29);
+}
+
+} // namespace
+
+RateLimiter& RateLimiter::getInstance() {
+    static RateLimiter instance;
+    return instance;
+}
+
+RateLimiter::RateLimiter() {
+    rz::services::MetricsService::getInstance().addCollector([this](std::string& out) {
+        out += "# HELP rz_rate_limit_buckets Live token buckets of the rate limiter.\n"
+               "# TYPE rz_rate_limit_buckets gauge\n";
+        out += std::format("rz_rate_limit_buckets {}\n", buckets());
+    });
+}
+
+std::expected<void, std::string> RateLimiter::configure() {
+    auto& config = AppConfig::getInstance();
+    auto& metrics = rz::services::MetricsService::getInstance();
+    auto rejectedSeries = [&metrics](std::string_view route) {
+        return metrics.registerCounter("rz_rate_limit_rejected_total", "Requests rejected with 429 per route policy.",
+                                       std::format("route=\"{}\"", route));
+    };
+
+    std::string errors;
+    auto enabled = config.getBool("RATE_LIMIT_ENABLED", true);
+    auto trust_proxy = config.getBool("RATE_LIMIT_TRUST_PROXY", false);
+    for (const auto* flag : {&enabled, &trust_proxy}) {
+        if (!*flag) errors += flag->error() + "; ";
+    }
+    m_enabled = enabled.value_or(true);
+    m_trustProxy = trust_proxy.value_or(false);
+    const int max_buckets = std::max(static_cast<int>(SHARD_COUNT), config.getInt("RATE_LIMIT_MAX_BUCKETS", 100000));
+    m_maxPerShard = static_cast<std::size_t>(max_buckets) / SHARD_COUNT;
+    double idle_sec = std::max(1, config.getInt("RATE_LIMIT_IDLE_SEC", 300));
+
+    m_policies.clear();
+
+    std::string routes = config.getString("RATE_LIMIT_ROUTES", "/system/test_email=5/60");
+    for (std::string_view entry : StringUtils::splitList(routes)) {
+        auto key_value = StringUtils::splitKeyValue(entry);
+        Policy policy;
+        if (!key_value || !parseLimit(key_value->second, policy.rate, policy.burst)) {
+            errors += std::format("invalid RATE_LIMIT_ROUTES entry '{}'; ", entry);
+            continue;
+        }
+        std::string_view pattern = key_value->first;
+        policy.route = RouteRegistry::getInstance().find(pattern);
+        if (!policy.route) {
+            errors += std::format("route '{}' is not registered; ", pattern);
+            continue;
+        }
+        policy.rejected_series = rejectedSeries(pattern);
+        idle_sec = std::max(idle_sec, policy.burst / policy.rate);
+        m_policies.push_back(policy);
+    }
+
+    m_hasDefault = false;
+    if (std::string spec = config.getString("RATE_LIMIT_DEFAULT", ""); !spec.empty()) {
+        if (parseLimit(spec, m_default.rate, m_default.burst)) {
+            m_default.rejected_series = rejectedSeries("default");
+            idle_sec = std::max(idle_sec, m_default.burst / m_default.rate);
+            m_hasDefault = true;
+        } else {
+            errors += std::format("invalid RATE_LIMIT_DEFAULT '{}'; ", spec);
+        }
+    }
+
+    // A bucket idle for longer than its refill time is full again, so dropping it is lossless
+    m_idleNs = static_cast<std::int64_t>(idle_sec * 1e9);
+
+    if (m_enabled) {
+        spdlog::info("Rate limiting: {} route policies{}, idle eviction after {:.0f} s", m_policies.size(),
+                     m_hasDefault ? " + default" : "", idle_sec);
+    }
+    if (!errors.empty()) {
+        errors.resize(errors.size() - 2);
+        return std::unexpected(errors);
+    }
+    return {};
+}
+
+const RateLimiter::Policy* RateLimiter::policyFor(const RouteInfo& route) const noexcept {
+    for (const auto& policy : m_policies) {
+        if (policy.route == &route) return &policy;
+    }
+    return m_hasDefault ? &m_default : nullptr;
+}
+
+std::string RateLimiter::clientAddress(const crow::request& req) const {
+    if (m_trustProxy) {
+        // The last hop was appended by our proxy; earlier entries are client-controlled
+        const std::string& forwarded = req.get_header_value("X-Forwarded-For");
+        if (!forwarded.empty()) {
+            auto comma = forwarded.rfind(',');
+            auto last = StringUtils::trim(comma == std::string::npos ? std::string_view(forwarded)
+                                                        : std::string_view(forwarded).substr(comma + 1));
+            if (!last.empty()) return std::string(last);
+        }
+    }
+    return req.remote_ip_address;
+}
+
+RateDecision RateLimiter::acquire(const RouteInfo& route, const crow::request& req) {
+    if (!m_enabled) return {};
+    const Policy* policy = policyFor(route);
+    if (!policy) return {};
+
+    const std::size_t index = policy == &m_default ? m_policies.size() : static_cast<std::size_t>(policy - m_policies.data());
+    const std::int64_t now = nowNs();
+
+    RateDecision decision = take(*policy, hashKey(index, 'i', clientAddress(req)), now);
+    if (decision.allowed) {
+        std::string_view auth = req.get_header_value("Authorization");
+        std::string_view token;
+        if (auth.starts_with("Bearer ")) {
+            token = auth.substr(7);
+        } else if (const char* param = req.url_params.get("token")) {
+            token = param;
+        }
+        if (!token.empty()) {
+            // A token shared across many addresses is limited as one client
+            decision = take(*policy, hashKey(index, 't', token), now);
+        }
+    }
+
+    if (!decision.allowed) {
+        rz::services::MetricsService::getInstance().increment(policy->rejected_series);
+    }
+    return decision;
+}
+
+RateDecision RateLimiter::take(const Policy& policy, std::uint64_t key, std::int64_t now_ns) {
+    auto& shard = m_shards[key >> 58]; // SHARD_COUNT == 64
+    std::lock_guard lock(shard.mutex);
+
+    if (now_ns >= shard.next_sweep_ns) {
+        sweep(shard, now_ns);
+    }
+
+    auto it = shard.buckets.find(key);
+    if (it == shard.buckets.end()) {
+        if (shard.buckets.size() >= m_maxPerShard) {
+            sweep(shard, now_ns);
+        }
+        it = shard.buckets.emplace(key, Bucket{policy.burst, now_ns}).first;
+        m_buckets.fetch_add(1, std::memory_order_relaxed);
+    }
+    Bucket& bucket = it->second;
+
+    const double elapsed = static_cast<double>(now_ns - bucket.last_ns) / 1e9;
+    bucket.tokens = std::min(policy.burst, bucket.tokens + elapsed * policy.rate);
+    bucket.last_ns = now_ns;
+
+    if (bucket.tokens >= 1.0) {
+        bucket.tokens -= 1.0;
+        return {};
+    }
+    return {false, std::max(1, static_cast<int>(std::ceil((1.0 - bucket.tokens) / policy.rate)))};
+}
+
+void RateLimiter::sweep(Shard& shard, std::int64_t now_ns) {
+    const std::size_t before = shard.buckets.size();
+    std::erase_if(shard.buckets, [&](const auto& entry) { return now_ns - entry.second.last_ns >= m_idleNs; });
+
+    // Still full (address spraying): drop arbitrary buckets; they restart full, i.e. fail open
+    while (shard.buckets.size() >= m_maxPerShard) {
+        shard.buckets.erase(shard.buckets.begin());
+    }
+
+    m_buckets.fetch_sub(before - shard.buckets.size(), std::memory_order_relaxed);
+    shard.next_sweep_ns = now_ns + m_idleNs / 4;
+}
+
+} // namespace rz::utils
@@ -0,0 +1,144 @@
+/**
+ * SPDX-FileComment: Request Arena Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file request_arena.cpp
+ * @brief Implementation of RequestArena.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/request_arena.hpp"
+#include "services/metrics_service.hpp"
+#include "utils/app_config.hpp"
+#include "utils/memory_accounting.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace rz::utils {
+
+namespace {
+
+std::atomic<std::size_t> g_initialBytes{16384};
+
+/**
+ * @brief Forwards to another resource and counts what passes through (debug builds).
+ */
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    CountingResource(std::pmr::memory_resource* target, std::uint64_t& allocations, std::uint64_t* bytes)
+        : m_target(target), m_allocations(allocations), m_bytes(bytes) {}
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++m_allocations;
+        if (m_bytes) *m_bytes += bytes;
+        return m_target->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        m_target->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* m_target;
+    std::uint64_t& m_allocations;
+    std::uint64_t* m_bytes;
+};
+
+// Initial buffers of all live thread arenas; blocks taken from the heap beyond them are not counted
+MemoryAccount& arenaMemory() {
+    static MemoryAccount& account = MemoryAccounting::getInstance().account("request_arenas");
+    return account;
+}
+
+struct ThreadArena {
+    ThreadArena()
+        : buffer(std::make_unique<std::byte[]>(g_initialBytes.load(std::memory_order_relaxed))),
+#ifndef NDEBUG
+          upstream(std::pmr::new_delete_resource(), stats.upstream_blocks, nullptr),
+          arena(buffer.get(), g_initialBytes.load(std::memory_order_relaxed), &upstream),
+          counting(&arena, stats.allocations, &stats.bytes) {
+#else
+          arena(buffer.get(), g_initialBytes.load(std::memory_order_relaxed), std::pmr::new_delete_resource()) {
+#endif
+        reserved = g_initialBytes.load(std::memory_order_relaxed);
+        arenaMemory().add(reserved);
+    }
+    ~ThreadArena() { arenaMemory().sub(reserved); }
+
+    RequestArena::Stats stats;
+    std::unique_ptr<std::byte[]> buffer;
+#ifndef NDEBUG
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena;
+    CountingResource counting;
+#else
+    std::pmr::monotonic_buffer_resource arena;
+#endif
+    std::size_t reserved = 0;
+};
+
+ThreadArena& threadArena() {
+    thread_local ThreadArena instance;
+    return instance;
+}
+
+#ifndef NDEBUG
+rz::services::SeriesId allocationsSeries() {
+    static const auto series = rz::services::MetricsService::getInstance().registerCounter(
+        "rz_request_arena_allocations_total", "Allocations served by request arenas (debug builds).");
+    return series;
+}
+
+rz::services::SeriesId upstreamSeries() {
+    static const auto series = rz::services::MetricsService::getInstance().registerCounter(
+        "rz_request_arena_upstream_blocks_total", "Heap blocks request arenas needed beyond their buffer (debug builds).");
+    return series;
+}
+#endif
+
+} // namespace
+
+void RequestArena::configure() {
+    auto& config = AppConfig::getInstance();
+    g_initialBytes.store(static_cast<std::size_t>(std::max(1024, config.getInt("REQUEST_ARENA_BYTES", 16384))));
+}
+
+std::pmr::memory_resource* RequestArena::resource() {
+#ifndef NDEBUG
+    return &threadArena().counting;
+#else
+    return &threadArena().arena;
+#endif
+}
+
+void RequestArena::reset() {
+    auto& arena = threadArena();
+#ifndef NDEBUG
+    if (arena.stats.allocations > 0) {
+        auto& metrics = rz::services::MetricsService::getInstance();
+        metrics.increment(allocationsSeries(), arena.stats.allocations);
+        metrics.increment(upstreamSeries(), arena.stats.upstream_blocks);
+        spdlog::trace("Request arena: {} allocations, {} bytes, {} heap blocks", arena.stats.allocations,
+                      arena.stats.bytes, arena.stats.upstream_blocks);
+    }
+    arena.stats = {};
+#endif
+    arena.arena.release();
+}
+
+RequestArena::Stats RequestArena::stats() {
+    return threadArena().stats;
+}
+
+} // namespace rz::utils
@@ -0,0 +1,117 @@
+/**
+ * SPDX-FileComment: Route Registry Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file route_registry.cpp
+ * @brief Implementation of RouteRegistry.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/route_registry.hpp"
+#include <format>
+
+namespace rz::utils {
+
+RouteRegistry& RouteRegistry::getInstance() {
+    static RouteRegistry instance;
+    return instance;
+}
+
+RouteRegistry::RouteRegistry() {
+    m_unmatched.pattern = "unmatched";
+    initSeries(m_unmatched, "unmatched");
+
+    rz::services::MetricsService::getInstance().addCollector([this](std::string& out) {
+        if (m_bulkheads.empty()) return;
+        out += "# HELP rz_bulkhead_inflight Requests running in a route bulkhead.\n"
+               "# TYPE rz_bulkhead_inflight gauge\n";
+        for (const auto& route : m_routes) {
+            if (!route.bulkhead) continue;
+            out += std::format("rz_bulkhead_inflight{{route=\"{}\"}} {}\n", route.pattern,
+                               route.bulkhead->inflight.load(std::memory_order_relaxed));
+        }
+        out += "# HELP rz_bulkhead_capacity Concurrency budget of a route bulkhead.\n"
+               "# TYPE rz_bulkhead_capacity gauge\n";
+        for (const auto& route : m_routes) {
+            if (!route.bulkhead) continue;
+            out += std::format("rz_bulkhead_capacity{{route=\"{}\"}} {}\n", route.pattern, route.bulkhead->capacity);
+        }
+    });
+}
+
+void RouteRegistry::initSeries(RouteInfo& info, std::string_view label) {
+    auto& metrics = rz::services::MetricsService::getInstance();
+    std::string route_label = "route=\"" + std::string(label) + "\"";
+
+    info.latency_series = metrics.registerHistogram(
+        "rz_http_request_duration_seconds", "Latency of HTTP requests per route.", route_label);
+    for (std::size_t i = 0; i < info.response_series.size(); ++i) {
+        info.response_series[i] = metrics.registerCounter(
+            "rz_http_responses_total", "HTTP responses per route and status class.",
+            route_label + ",code=\"" + std::to_string(i + 1) + "xx\"");
+    }
+}
+
+const RouteInfo& RouteRegistry::declare(std::string_view pattern) {
+    return entry(pattern);
+}
+
+RouteInfo& RouteRegistry::entry(std::string_view pattern) {
+    for (auto& route : m_routes) {
+        if (route.pattern == pattern) return route;
+    }
+
+    RouteInfo& info = m_routes.emplace_back();
+    info.pattern = std::string(pattern);
+    auto param = pattern.find('<');
+    info.has_params = param != std::string_view::npos;
+    info.prefix = std::string(pattern.substr(0, param));
+    initSeries(info, pattern);
+    return info;
+}
+
+const RouteInfo& RouteRegistry::declare(std::string_view pattern, int max_concurrent) {
+    RouteInfo& info = entry(pattern);
+    if (max_concurrent <= 0) return info;
+
+    if (!info.bulkhead) {
+        info.bulkhead = &m_bulkheads.emplace_back();
+        info.bulkhead->rejected_series = rz::services::MetricsService::getInstance().registerCounter(
+            "rz_bulkhead_rejected_total", "Requests rejected because the route bulkhead was full.",
+            "route=\"" + info.pattern + "\"");
+    }
+    info.bulkhead->capacity = max_concurrent;
+    return info;
+}
+
+const RouteInfo& RouteRegistry::match(std::string_view url) const noexcept {
+    // Exact match first, then the longest parameterized prefix
+    const RouteInfo* best = nullptr;
+    for (const auto& route : m_routes) {
+        if (!route.has_params) {
+            if (route.pattern == url) return route;
+        } else if (url.starts_with(route.prefix) &&
+                   (!best || route.prefix.size() > best->prefix.size())) {
+            best = &route;
+        }
+    }
+    return best ? *best : m_unmatched;
+}
+
+const RouteInfo* RouteRegistry::find(std::string_view pattern) const noexcept {
+    for (const auto& route : m_routes) {
+        if (route.pattern == pattern) return &route;
+    }
+    return nullptr;
+}
+
+} // namespace rz::utils
@@ -0,0 +1,114 @@
+/**
+ * SPDX-FileComment: Startup Profiler Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file startup_profiler.cpp
+ * @brief Implementation of StartupProfiler.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/startup_profiler.hpp"
+#include "utils/json_writer.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace rz::utils {
+
+namespace {
+
+double millis(StartupProfiler::Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // namespace
+
+StartupProfiler::Phase::Phase(StartupProfiler& profiler, std::string name)
+    : m_profiler(profiler), m_name(std::move(name)), m_start(Clock::now()) {}
+
+void StartupProfiler::Phase::end() {
+    if (m_ended) return;
+    m_ended = true;
+    m_profiler.record(std::move(m_name), m_start, Clock::now());
+}
+
+StartupProfiler& StartupProfiler::getInstance() {
+    static StartupProfiler instance;
+    return instance;
+}
+
+StartupProfiler::StartupProfiler() : m_begin(Clock::now()) {}
+
+void StartupProfiler::begin() {
+    std::lock_guard lock(m_mutex);
+    m_begin = Clock::now();
+    m_records.clear();
+    m_timeToReadyMs = 0;
+    m_ready.store(false, std::memory_order_release);
+}
+
+void StartupProfiler::record(std::string name, Clock::time_point start, Clock::time_point end) {
+    std::lock_guard lock(m_mutex);
+    m_records.push_back({std::move(name), millis(start - m_begin), millis(end - start)});
+}
+
+void StartupProfiler::markReady() {
+    std::vector<Record> timeline;
+    double total;
+    {
+        std::lock_guard lock(m_mutex);
+        m_timeToReadyMs = millis(Clock::now() - m_begin);
+        total = m_timeToReadyMs;
+        timeline = m_records;
+    }
+    m_ready.store(true, std::memory_order_release);
+
+    std::sort(timeline.begin(), timeline.end(),
+              [](const Record& a, const Record& b) { return a.start_ms < b.start_ms; });
+    double sum = 0;
+    for (const auto& r : timeline) {
+        spdlog::info("Startup phase {:<16} +{:8.1f} ms  {:8.1f} ms", r.name, r.start_ms, r.duration_ms);
+        sum += r.duration_ms;
+    }
+    // Phases that ran concurrently add up to more than the wall time
+    spdlog::info("Ready in {:.1f} ms (phases sum to {:.1f} ms)", total, sum);
+}
+
+double StartupProfiler::timeToReadyMs() const {
+    std::lock_guard lock(m_mutex);
+    return m_timeToReadyMs;
+}
+
+std::vector<StartupProfiler::Record> StartupProfiler::records() const {
+    std::lock_guard lock(m_mutex);
+    return m_records;
+}
+
+std::string StartupProfiler::toJson() const {
+    std::lock_guard lock(m_mutex);
+    JsonWriter json(128 + m_records.size() * 64);
+    json.beginObject()
+        .field<"complete">(m_ready.load(std::memory_order_acquire))
+        .field<"time_to_ready_ms">(m_timeToReadyMs)
+        .key<"phases">()
+        .beginArray();
+    for (const auto& r : m_records) {
+        json.beginObject()
+            .field<"name">(r.name)
+            .field<"start_ms">(r.start_ms)
+            .field<"duration_ms">(r.duration_ms)
+            .endObject();
+    }
+    json.endArray().endObject();
+    return json.take();
+}
+
+} // namespace rz::utils
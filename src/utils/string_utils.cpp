@@ -0,0 +1,48 @@
+/**
+ * SPDX-FileComment: String Utilities Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file string_utils.cpp
+ * @brief Implementation of StringUtils.
+ * @version 0.1.0
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/string_utils.hpp"
+
+namespace rz::utils {
+
+std::string_view StringUtils::trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+std::vector<std::string_view> StringUtils::splitList(std::string_view list) {
+    std::vector<std::string_view> entries;
+    while (!list.empty()) {
+        auto end = list.find(';');
+        std::string_view entry = trim(list.substr(0, end));
+        list = end == std::string_view::npos ? std::string_view{} : list.substr(end + 1);
+        if (!entry.empty()) entries.push_back(entry);
+    }
+    return entries;
+}
+
+std::optional<std::pair<std::string_view, std::string_view>> StringUtils::splitKeyValue(std::string_view entry) {
+    auto eq = entry.rfind('=');
+    if (eq == std::string_view::npos) return std::nullopt;
+    std::string_view key = trim(entry.substr(0, eq));
+    if (key.empty()) return std::nullopt;
+    return std::pair{key, trim(entry.substr(eq + 1))};
+}
+
+} // namespace rz::utils
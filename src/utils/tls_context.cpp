@@ -0,0 +1,301 @@
+/**
+ * SPDX-FileComment: TLS Context Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file tls_context.cpp
+ * @brief Implementation of TlsContext.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#ifdef CROW_ENABLE_SSL
+
+#include "utils/tls_context.hpp"
+#include "utils/app_config.hpp"
+#include <spdlog/spdlog.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <mutex>
+
+namespace rz::utils {
+
+namespace {
+
+using rz::services::MetricsService;
+
+std::string opensslError(std::string_view what) {
+    char buffer[256];
+    ERR_error_string_n(ERR_get_error(), buffer, sizeof(buffer));
+    return std::format("{}: {}", what, buffer);
+}
+
+// HMAC-SHA256(secret, "rz-ticket-key:<epoch>:<label>"), truncated to out.size()
+template <std::size_t N>
+bool deriveKey(const std::string& secret, std::int64_t epoch, std::string_view label,
+               std::array<unsigned char, N>& out) {
+    const std::string info = std::format("rz-ticket-key:{}:{}", epoch, label);
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    if (!HMAC(EVP_sha256(), secret.data(), static_cast<int>(secret.size()),
+              reinterpret_cast<const unsigned char*>(info.data()), info.size(), digest, &length) ||
+        length < N) {
+        return false;
+    }
+    std::memcpy(out.data(), digest, N);
+    return true;
+}
+
+} // namespace
+
+TlsContext& TlsContext::getInstance() {
+    static TlsContext instance;
+    return instance;
+}
+
+TlsContext::TlsContext() {
+    MetricsService::getInstance().addCollector([this](std::string& out) {
+        if (!m_ctx) return;
+        std::size_t keys;
+        {
+            std::shared_lock lock(m_keysMutex);
+            keys = m_keys.size();
+        }
+        out += "# HELP rz_tls_session_cache_sessions Sessions held in the TLS session cache.\n"
+               "# TYPE rz_tls_session_cache_sessions gauge\n";
+        out += std::format("rz_tls_session_cache_sessions {}\n", SSL_CTX_sess_number(m_ctx));
+        out += "# HELP rz_tls_ticket_keys Session ticket keys accepted for decryption.\n"
+               "# TYPE rz_tls_ticket_keys gauge\n";
+        out += std::format("rz_tls_ticket_keys {}\n", keys);
+    });
+}
+
+std::expected<crow::ssl_context_t, std::string> TlsContext::create() {
+    auto& config = AppConfig::getInstance();
+    auto& metrics = MetricsService::getInstance();
+
+    crow::ssl_context_t context(crow::ssl_context_t::tls_server);
+    SSL_CTX* ctx = context.native_handle();
+
+    const std::string min_version = config.getString("TLS_MIN_VERSION", "1.2");
+    SSL_CTX_set_min_proto_version(ctx, min_version == "1.3" ? TLS1_3_VERSION : TLS1_2_VERSION);
+    SSL_CTX_set_options(ctx, SSL_OP_CIPHER_SERVER_PREFERENCE | SSL_OP_NO_RENEGOTIATION);
+    // X25519 and P-256 are the cheapest key exchanges on both ends
+    const std::string groups = config.getString("TLS_GROUPS", "X25519:P-256:P-384");
+    if (SSL_CTX_set1_groups_list(ctx, groups.c_str()) != 1) {
+        return std::unexpected(opensslError(std::format("TLS_GROUPS '{}'", groups)));
+    }
+
+    // OpenSSL keeps one certificate per key type and picks the one the client supports
+    auto load = [ctx](const std::string& cert, const std::string& key) -> std::expected<void, std::string> {
+        if (SSL_CTX_use_certificate_chain_file(ctx, cert.c_str()) != 1) {
+            return std::unexpected(opensslError(std::format("certificate {}", cert)));
+        }
+        if (SSL_CTX_use_PrivateKey_file(ctx, key.c_str(), SSL_FILETYPE_PEM) != 1) {
+            return std::unexpected(opensslError(std::format("private key {}", key)));
+        }
+        if (SSL_CTX_check_private_key(ctx) != 1) {
+            return std::unexpected(opensslError(std::format("private key {} does not match {}", key, cert)));
+        }
+        return {};
+    };
+    const std::string cert = config.getString("TLS_CERT_FILE", "");
+    const std::string ecdsa_cert = config.getString("TLS_ECDSA_CERT_FILE", "");
+    if (cert.empty() && ecdsa_cert.empty()) {
+        return std::unexpected("neither TLS_CERT_FILE nor TLS_ECDSA_CERT_FILE is set");
+    }
+    if (!cert.empty()) {
+        if (auto res = load(cert, config.getString("TLS_KEY_FILE", "")); !res) return std::unexpected(res.error());
+    }
+    if (!ecdsa_cert.empty()) {
+        if (auto res = load(ecdsa_cert, config.getString("TLS_ECDSA_KEY_FILE", "")); !res) {
+            return std::unexpected(res.error());
+        }
+    }
+
+    // Session cache: one per SSL_CTX, shared by all I/O threads of this process
+    static const unsigned char session_id_context[] = "rz";
+    SSL_CTX_set_session_id_context(ctx, session_id_context, sizeof(session_id_context) - 1);
+    const int cache_size = config.getInt("TLS_SESSION_CACHE_SIZE", 20480);
+    if (cache_size > 0) {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(ctx, cache_size);
+    } else {
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+    }
+    const int lifetime = std::max(1, config.getInt("TLS_SESSION_TIMEOUT_SEC", 3600));
+    SSL_CTX_set_timeout(ctx, lifetime);
+
+    // Session tickets with our own rotating keys
+    m_ticketSecret = config.getString("TLS_TICKET_SECRET", "");
+    m_rotateSec = std::max(60, config.getInt("TLS_TICKET_ROTATE_SEC", 3600));
+    m_keepKeys = static_cast<std::size_t>(std::max(1, config.getInt("TLS_TICKET_KEYS", 3)));
+    auto tickets_flag = config.getBool("TLS_TICKETS", true);
+    if (!tickets_flag) return std::unexpected(tickets_flag.error());
+    const bool tickets = *tickets_flag;
+    std::string ticket_mode = "off";
+    if (!tickets) {
+        // TLS 1.3 then resumes through stateful tickets from the session cache
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    } else {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        {
+            std::unique_lock lock(m_keysMutex);
+            m_keys.clear();
+            const std::int64_t epoch = currentEpoch();
+            // Derived keys of the previous epochs still decrypt tickets issued before a restart
+            const std::int64_t first =
+                m_ticketSecret.empty() ? epoch : epoch - static_cast<std::int64_t>(m_keepKeys) + 1;
+            for (std::int64_t e = first; e <= epoch; ++e) {
+                TicketKey key;
+                if (!makeKey(e, key)) return std::unexpected(opensslError("ticket key"));
+                m_keys.push_front(key);
+            }
+            m_epoch.store(epoch);
+        }
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &TlsContext::ticketCallback);
+        ticket_mode = std::format("{} keys, rotated every {} s", m_ticketSecret.empty() ? "random" : "derived",
+                                  m_rotateSec);
+#else
+        ticket_mode = "OpenSSL built-in key (no rotation, needs OpenSSL 3)";
+#endif
+    }
+
+    if (m_countedIndex < 0) {
+        m_countedIndex = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    }
+    SSL_CTX_set_info_callback(ctx, &TlsContext::infoCallback);
+
+    const char* help = "Completed TLS handshakes.";
+    m_fullSeries = metrics.registerCounter("rz_tls_handshakes_total", help, "type=\"full\"");
+    m_resumedSeries = metrics.registerCounter("rz_tls_handshakes_total", help, "type=\"resumed\"");
+    help = "Session tickets issued and presented, by outcome.";
+    m_issuedSeries = metrics.registerCounter("rz_tls_tickets_total", help, "result=\"issued\"");
+    m_acceptedSeries = metrics.registerCounter("rz_tls_tickets_total", help, "result=\"accepted\"");
+    m_renewedSeries = metrics.registerCounter("rz_tls_tickets_total", help, "result=\"renewed\"");
+    m_unknownKeySeries = metrics.registerCounter("rz_tls_tickets_total", help, "result=\"unknown_key\"");
+    m_rotationSeries = metrics.registerCounter("rz_tls_ticket_key_rotations_total", "Session ticket key rotations.");
+
+    // Crow owns the context from here on; the collector keeps its own reference
+    if (m_ctx) SSL_CTX_free(m_ctx);
+    SSL_CTX_up_ref(ctx);
+    m_ctx = ctx;
+
+    spdlog::info("TLS: min version {}, {}{}, session cache {}, tickets: {}", min_version,
+                 cert.empty() ? "" : "RSA", ecdsa_cert.empty() ? "" : (cert.empty() ? "ECDSA" : " + ECDSA"),
+                 cache_size > 0 ? std::to_string(cache_size) : "off", ticket_mode);
+    return context;
+}
+
+std::int64_t TlsContext::currentEpoch() const {
+    // Wall clock, so that workers and hosts sharing TLS_TICKET_SECRET agree on the epoch
+    const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return now / m_rotateSec;
+}
+
+bool TlsContext::makeKey(std::int64_t epoch, TicketKey& key) const {
+    key.epoch = epoch;
+    if (m_ticketSecret.empty()) {
+        return RAND_bytes(key.name.data(), static_cast<int>(key.name.size())) == 1 &&
+               RAND_bytes(key.aes.data(), static_cast<int>(key.aes.size())) == 1 &&
+               RAND_bytes(key.hmac.data(), static_cast<int>(key.hmac.size())) == 1;
+    }
+    return deriveKey(m_ticketSecret, epoch, "name", key.name) && deriveKey(m_ticketSecret, epoch, "aes", key.aes) &&
+           deriveKey(m_ticketSecret, epoch, "hmac", key.hmac);
+}
+
+void TlsContext::rotate(std::int64_t epoch) {
+    std::unique_lock lock(m_keysMutex);
+    if (!m_keys.empty() && m_keys.front().epoch >= epoch) return; // Rotated by another handshake
+    TicketKey key;
+    if (!makeKey(epoch, key)) {
+        spdlog::error("{}", opensslError("TLS ticket key rotation"));
+        return;
+    }
+    m_keys.push_front(key);
+    while (m_keys.size() > m_keepKeys) m_keys.pop_back();
+    m_epoch.store(epoch, std::memory_order_relaxed);
+    MetricsService::getInstance().increment(m_rotationSeries);
+}
+
+void TlsContext::infoCallback(const SSL* ssl, int where, int /*ret*/) {
+    if (!(where & SSL_CB_HANDSHAKE_DONE)) return;
+    auto& self = getInstance();
+    // TLS 1.3 reports post-handshake messages (tickets, key updates) as handshakes too
+    auto* connection = const_cast<SSL*>(ssl);
+    if (SSL_get_ex_data(connection, self.m_countedIndex)) return;
+    SSL_set_ex_data(connection, self.m_countedIndex, connection);
+    MetricsService::getInstance().increment(SSL_session_reused(connection) ? self.m_resumedSeries : self.m_fullSeries);
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int TlsContext::ticketCallback(SSL* /*ssl*/, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* cipher,
+                               EVP_MAC_CTX* mac, int encrypt) {
+    auto& self = getInstance();
+    auto& metrics = MetricsService::getInstance();
+    if (const auto epoch = self.currentEpoch(); epoch > self.m_epoch.load(std::memory_order_relaxed)) {
+        self.rotate(epoch);
+    }
+
+    std::shared_lock lock(self.m_keysMutex);
+    const TicketKey* key = nullptr;
+    if (encrypt) {
+        if (self.m_keys.empty()) return -1;
+        key = &self.m_keys.front();
+        std::memcpy(name, key->name.data(), key->name.size());
+        if (RAND_bytes(iv, 16) != 1) return -1;
+        if (EVP_EncryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key->aes.data(), iv) != 1) return -1;
+    } else {
+        auto it = std::find_if(self.m_keys.begin(), self.m_keys.end(), [name](const TicketKey& k) {
+            return std::memcmp(k.name.data(), name, k.name.size()) == 0;
+        });
+        if (it == self.m_keys.end()) {
+            metrics.increment(self.m_unknownKeySeries);
+            return 0; // Expired key: full handshake
+        }
+        key = &*it;
+        if (EVP_DecryptInit_ex(cipher, EVP_aes_256_cbc(), nullptr, key->aes.data(), iv) != 1) return -1;
+    }
+
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, const_cast<unsigned char*>(key->hmac.data()),
+                                          key->hmac.size()),
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+        OSSL_PARAM_construct_end(),
+    };
+    if (EVP_MAC_CTX_set_params(mac, params) != 1) return -1;
+
+    if (encrypt) {
+        metrics.increment(self.m_issuedSeries);
+        return 1;
+    }
+    if (key == &self.m_keys.front()) {
+        metrics.increment(self.m_acceptedSeries);
+        return 1;
+    }
+    metrics.increment(self.m_renewedSeries);
+    return 2; // Valid under an older key: resume and issue a ticket under the current one
+}
+#endif
+
+} // namespace rz::utils
+
+#endif // CROW_ENABLE_SSL
@@ -2,8 +2,8 @@
  * @file token_utils.cpp
  * @author ZHENG Robert (robert@hase-zheng.net)
  * @brief JWT Token Utilities Implementation
- * @version 0.16.0
- * @date 2026-01-31
+ * @version 0.16.1
+ * @date 2026-10-18
  *
  * @copyright Copyright (c) 2026 ZHENG Robert
  *
@@ -12,6 +12,7 @@
 
 #include "utils/token_utils.hpp"
 #include "utils/app_config.hpp" // Using AppConfig instead of EnvLoader
+#include "services/metrics_service.hpp"
 #include <chrono>
 #include <iostream>
 
@@ -74,6 +75,13 @@ std::string TokenUtils::generateToken(const std::string &userId, const std::stri
  */
 std::optional<TokenPayload>
 TokenUtils::verifyToken(const std::string &rawToken) {
+  auto &metrics = rz::services::MetricsService::getInstance();
+  static const auto verify_series = metrics.registerHistogram(
+      "rz_jwt_verify_duration_seconds", "Latency of JWT verification.");
+  static const auto failure_series = metrics.registerCounter(
+      "rz_jwt_verify_failures_total", "Rejected JWTs (invalid, expired or malformed).");
+  rz::services::MetricsTimer timer(verify_series);
+
   try {
     auto verifier = jwt::verify()
                         .allow_algorithm(jwt::algorithm::hs256{getSecret()})
@@ -100,6 +108,7 @@ TokenUtils::verifyToken(const std::string &rawToken) {
 
   } catch (const std::exception &e) {
     // std::cerr << "Token Verify Failed: " << e.what() << std::endl;
+    metrics.increment(failure_series);
     return std::nullopt;
   }
 }
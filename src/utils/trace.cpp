@@ -0,0 +1,210 @@
+/**
+ * SPDX-FileComment: Request Tracing Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file trace.cpp
+ * @brief Implementation of Tracer and TraceSpan.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/trace.hpp"
+#include "utils/app_config.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace rz::utils {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t MAX_SPANS = 64;
+constexpr std::size_t MAX_REQUEST_ID = 64;
+
+struct Span {
+    const char* name;
+    Clock::time_point start;
+    Clock::duration duration;
+    std::uint8_t depth;
+};
+
+struct ThreadTrace {
+    bool active = false;
+    std::uint64_t generation = 0;
+    std::array<char, MAX_REQUEST_ID> request_id{};
+    std::size_t request_id_len = 0;
+    std::string_view route;
+    Clock::time_point start;
+    std::array<Span, MAX_SPANS> spans{};
+    std::size_t count = 0;
+    std::size_t dropped = 0;
+    std::uint8_t depth = 0;
+    std::uint64_t rng_state = 0;
+};
+
+thread_local ThreadTrace t_trace;
+
+// Configuration (written once in configure(), read-only afterwards)
+bool g_enabled = true;
+Clock::duration g_slowThreshold = std::chrono::milliseconds(250);
+std::string g_chromeFile;
+std::mutex g_chromeMutex;
+std::atomic<std::uint64_t> g_generation{0};
+
+std::uint64_t nextRandom(ThreadTrace& trace) {
+    if (trace.rng_state == 0) {
+        trace.rng_state = std::random_device{}() | (static_cast<std::uint64_t>(std::random_device{}()) << 32) | 1;
+    }
+    // xorshift64*
+    trace.rng_state ^= trace.rng_state >> 12;
+    trace.rng_state ^= trace.rng_state << 25;
+    trace.rng_state ^= trace.rng_state >> 27;
+    return trace.rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+double toMillis(Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+long long toMicros(Clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+std::string renderBreakdown(const ThreadTrace& trace, Clock::duration total, int status) {
+    std::string line = std::format("Slow request {} {} -> {} in {:.2f} ms:",
+                                   std::string_view(trace.request_id.data(), trace.request_id_len),
+                                   trace.route, status, toMillis(total));
+    for (std::size_t i = 0; i < trace.count; ++i) {
+        const Span& span = trace.spans[i];
+        line += std::format(" {}{}={:.3f}ms", std::string(span.depth, '>'), span.name, toMillis(span.duration));
+    }
+    if (trace.dropped > 0) line += std::format(" (+{} spans dropped)", trace.dropped);
+    return line;
+}
+
+void writeChromeTrace(const ThreadTrace& trace, Clock::duration total, int status) {
+    const auto tid = static_cast<long>(::syscall(SYS_gettid));
+    const auto pid = static_cast<long>(::getpid());
+    const std::string_view rid(trace.request_id.data(), trace.request_id_len);
+
+    std::string events = std::format(
+        "{{\"name\":\"{}\",\"cat\":\"request\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":{},\"tid\":{},"
+        "\"args\":{{\"request_id\":\"{}\",\"status\":{}}}}},\n",
+        trace.route, toMicros(trace.start.time_since_epoch()), toMicros(total), pid, tid, rid, status);
+    for (std::size_t i = 0; i < trace.count; ++i) {
+        const Span& span = trace.spans[i];
+        events += std::format(
+            "{{\"name\":\"{}\",\"cat\":\"span\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":{},\"tid\":{},"
+            "\"args\":{{\"request_id\":\"{}\"}}}},\n",
+            span.name, toMicros(span.start.time_since_epoch()), toMicros(span.duration), pid, tid, rid);
+    }
+
+    // JSON array format: the closing bracket is optional for chrome://tracing / Perfetto
+    std::lock_guard lock(g_chromeMutex);
+    std::ofstream out(g_chromeFile, std::ios::app);
+    if (out.tellp() == 0) out << "[\n";
+    out << events;
+}
+
+} // namespace
+
+void Tracer::configure() {
+    auto& config = AppConfig::getInstance();
+    auto enabled = config.getBool("TRACE_ENABLED", true);
+    if (!enabled) spdlog::warn("{}", enabled.error());
+    g_enabled = enabled.value_or(true);
+    g_slowThreshold = std::chrono::milliseconds(std::max(0, config.getInt("TRACE_SLOW_MS", 250)));
+    g_chromeFile = config.getString("TRACE_CHROME_FILE", "");
+}
+
+std::uint64_t Tracer::beginRequest(std::string_view request_id, std::string_view route) {
+    if (!g_enabled) return 0;
+
+    ThreadTrace& trace = t_trace;
+    trace.active = true;
+    trace.generation = g_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+    trace.route = route;
+    trace.count = 0;
+    trace.dropped = 0;
+    trace.depth = 0;
+
+    // Accept only a sane incoming ID, otherwise generate one
+    bool valid = !request_id.empty() && request_id.size() <= MAX_REQUEST_ID &&
+                 std::all_of(request_id.begin(), request_id.end(), [](char c) {
+                     return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.';
+                 });
+    if (valid) {
+        std::copy(request_id.begin(), request_id.end(), trace.request_id.begin());
+        trace.request_id_len = request_id.size();
+    } else {
+        auto result = std::format_to_n(trace.request_id.data(), trace.request_id.size(), "{:016x}", nextRandom(trace));
+        trace.request_id_len = static_cast<std::size_t>(result.size);
+    }
+
+    trace.start = Clock::now();
+    return trace.generation;
+}
+
+void Tracer::endRequest(std::uint64_t generation, int status) {
+    ThreadTrace& trace = t_trace;
+    // Async responses may complete after another request started on this thread
+    if (!trace.active || generation == 0 || trace.generation != generation) return;
+    trace.active = false;
+
+    auto total = Clock::now() - trace.start;
+    if (total < g_slowThreshold) return;
+
+    spdlog::warn("{}", renderBreakdown(trace, total, status));
+    if (!g_chromeFile.empty()) {
+        writeChromeTrace(trace, total, status);
+    }
+}
+
+std::string_view Tracer::requestId() {
+    const ThreadTrace& trace = t_trace;
+    if (!trace.active) return {};
+    return {trace.request_id.data(), trace.request_id_len};
+}
+
+TraceSpan::TraceSpan(const char* name) noexcept : m_index(-1) {
+    ThreadTrace& trace = t_trace;
+    if (!trace.active) return;
+    if (trace.count >= MAX_SPANS) {
+        ++trace.dropped;
+        return;
+    }
+    m_index = static_cast<int>(trace.count++);
+    trace.spans[m_index] = Span{name, Clock::now(), Clock::duration::zero(), trace.depth};
+    ++trace.depth;
+}
+
+TraceSpan::~TraceSpan() {
+    if (m_index < 0) return;
+    ThreadTrace& trace = t_trace;
+    if (!trace.active || static_cast<std::size_t>(m_index) >= trace.count) return;
+    Span& span = trace.spans[m_index];
+    span.duration = Clock::now() - span.start;
+    if (trace.depth > 0) --trace.depth;
+}
+
+} // namespace rz::utils
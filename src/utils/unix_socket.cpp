@@ -0,0 +1,161 @@
+/**
+ * SPDX-FileComment: Unix Socket Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file unix_socket.cpp
+ * @brief Implementation of UnixSocket.
+ * @version 0.1.1
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/unix_socket.hpp"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+
+#include <grp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace rz::utils {
+
+namespace {
+
+// The socket file this process published; remove() leaves files bound by a successor alone
+struct stat g_published{};
+bool g_hasPublished = false;
+
+// Connects to @p path: true if a server accepts, false if refused, an error otherwise
+std::expected<bool, std::string> probe(const std::string& path) {
+    sockaddr_un addr{};
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return std::unexpected(std::format("socket(): {}", std::strerror(errno)));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    const int rc = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    const int err = errno;
+    ::close(fd);
+
+    if (rc == 0) return true;
+    if (err == ECONNREFUSED) return false;
+    return std::unexpected(std::format("cannot probe '{}': {}", path, std::strerror(err)));
+}
+
+// Checks that @p path is absent or a socket; @return true if it exists
+std::expected<bool, std::string> inspect(const std::string& path) {
+    struct stat st{};
+    if (::lstat(path.c_str(), &st) != 0) {
+        if (errno == ENOENT) return false;
+        return std::unexpected(std::format("cannot stat '{}': {}", path, std::strerror(errno)));
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        return std::unexpected(std::format("'{}' exists and is not a socket", path));
+    }
+    return true;
+}
+
+} // namespace
+
+std::string UnixSocket::pathFor(const std::string& path, int worker_index) {
+    if (path.empty() || worker_index < 0) return path;
+    // AF_UNIX sockets cannot be shared with SO_REUSEPORT, so every worker binds its own
+    return std::format("{}.{}", path, worker_index);
+}
+
+std::expected<std::string, std::string> UnixSocket::prepare(const std::string& path, bool takeover) {
+    const std::string bind_path = path + ".new";
+    sockaddr_un addr{};
+    if (bind_path.size() >= sizeof(addr.sun_path)) {
+        return std::unexpected(
+            std::format("socket path '{}' exceeds {} bytes", bind_path, sizeof(addr.sun_path) - 1));
+    }
+
+    // A socket file without a listener refuses connections; one with a listener belongs to a live server
+    auto exists = inspect(path);
+    if (!exists) return std::unexpected(exists.error());
+    if (*exists) {
+        auto listening = probe(path);
+        if (!listening) return std::unexpected(listening.error());
+        if (*listening && !takeover) {
+            return std::unexpected(std::format("another server is listening on '{}'", path));
+        }
+        if (!*listening) spdlog::warn("Replacing stale Unix socket {}", path);
+    }
+
+    // A leftover bind path is either stale or another process of this slot is still starting
+    exists = inspect(bind_path);
+    if (!exists) return std::unexpected(exists.error());
+    if (*exists) {
+        auto listening = probe(bind_path);
+        if (!listening) return std::unexpected(listening.error());
+        if (*listening) return std::unexpected(std::format("another server is starting on '{}'", bind_path));
+        if (::unlink(bind_path.c_str()) != 0 && errno != ENOENT) {
+            return std::unexpected(
+                std::format("cannot remove stale socket '{}': {}", bind_path, std::strerror(errno)));
+        }
+    }
+    return bind_path;
+}
+
+std::expected<void, std::string> UnixSocket::secure(const std::string& path, std::string_view mode,
+                                                    const std::string& group) {
+    if (!group.empty()) {
+        // Called once at startup from the main thread, so the non-reentrant lookup is fine
+        const struct group* entry = ::getgrnam(group.c_str());
+        if (!entry) return std::unexpected(std::format("unknown group '{}'", group));
+        if (::chown(path.c_str(), static_cast<uid_t>(-1), entry->gr_gid) != 0) {
+            return std::unexpected(std::format("chown '{}' to group {}: {}", path, group, std::strerror(errno)));
+        }
+    }
+    if (!mode.empty()) {
+        unsigned bits = 0;
+        auto [ptr, ec] = std::from_chars(mode.data(), mode.data() + mode.size(), bits, 8);
+        if (ec != std::errc{} || ptr != mode.data() + mode.size() || bits > 07777) {
+            return std::unexpected(std::format("invalid socket mode '{}'", mode));
+        }
+        if (::chmod(path.c_str(), static_cast<mode_t>(bits)) != 0) {
+            return std::unexpected(std::format("chmod '{}' to {}: {}", path, mode, std::strerror(errno)));
+        }
+    }
+    return {};
+}
+
+std::expected<void, std::string> UnixSocket::publish(const std::string& bind_path, const std::string& path) {
+    // rename() swaps the file atomically: connects reach either the old or the new listener, never no file
+    if (::rename(bind_path.c_str(), path.c_str()) != 0) {
+        const int err = errno;
+        ::unlink(bind_path.c_str());
+        return std::unexpected(std::format("rename '{}' to '{}': {}", bind_path, path, std::strerror(err)));
+    }
+    if (::lstat(path.c_str(), &g_published) != 0) {
+        return std::unexpected(std::format("cannot stat '{}': {}", path, std::strerror(errno)));
+    }
+    g_hasPublished = true;
+    return {};
+}
+
+void UnixSocket::remove(const std::string& path) {
+    struct stat st{};
+    if (path.empty() || !g_hasPublished || ::lstat(path.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode)) return;
+    if (st.st_dev != g_published.st_dev || st.st_ino != g_published.st_ino) {
+        spdlog::debug("Unix socket {} was replaced by another process, leaving it", path);
+        return;
+    }
+    if (::unlink(path.c_str()) != 0) {
+        spdlog::warn("Cannot remove Unix socket {}: {}", path, std::strerror(errno));
+    }
+}
+
+} // namespace rz::utils
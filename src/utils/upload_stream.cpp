@@ -0,0 +1,523 @@
+/**
+ * SPDX-FileComment: Streaming Upload Helpers Implementation
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file upload_stream.cpp
+ * @brief Implementation of MultipartScanner, UploadSink, UploadStream and the Crow parser hooks.
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ */
+
+#include "utils/upload_stream.hpp"
+#include "utils/app_config.hpp"
+#include "utils/string_utils.hpp"
+#include <crow.h>
+#include <openssl/evp.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace rz::utils {
+
+namespace {
+
+constexpr std::string_view UPLOAD_PREFIX = "/api/uploads/";
+constexpr std::size_t MAX_PART_HEADERS = 16 * 1024;
+constexpr std::uint64_t MULTIPART_OVERHEAD = 64 * 1024; // Boundaries and part headers on top of the limit
+
+std::filesystem::path g_directory{"./data/uploads"};
+std::uint64_t g_maxBytes = 100ULL * 1024 * 1024;
+
+std::string toLower(std::string_view sv) {
+    std::string out(sv);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+// Value of a "key=value" / key="value" parameter of a header, empty if absent
+std::string headerParam(std::string_view header, std::string_view key) {
+    std::string lower = toLower(header);
+    std::string needle = std::string(key) + "=";
+    std::size_t pos = 0;
+    while ((pos = lower.find(needle, pos)) != std::string::npos) {
+        // Must start a parameter, not be the tail of another one (name= vs filename=)
+        if (pos == 0 || lower[pos - 1] == ';' || lower[pos - 1] == ' ' || lower[pos - 1] == '\t') break;
+        pos += needle.size();
+    }
+    if (pos == std::string::npos) return {};
+
+    std::string_view value = header.substr(pos + needle.size());
+    if (value.starts_with('"')) {
+        value.remove_prefix(1);
+        return std::string(value.substr(0, value.find('"')));
+    }
+    return std::string(StringUtils::trim(value.substr(0, value.find(';'))));
+}
+
+std::string sha256Hex(evp_md_ctx_st* ctx) {
+    std::array<unsigned char, EVP_MAX_MD_SIZE> digest{};
+    unsigned int len = 0;
+    EVP_DigestFinal_ex(ctx, digest.data(), &len);
+
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(len * 2);
+    for (unsigned int i = 0; i < len; ++i) {
+        hex.push_back(HEX[digest[i] >> 4]);
+        hex.push_back(HEX[digest[i] & 0x0F]);
+    }
+    return hex;
+}
+
+} // namespace
+
+// --- MultipartScanner ---
+
+MultipartScanner::MultipartScanner(std::string_view boundary)
+    : m_delimiter("\r\n--" + std::string(boundary)),
+      m_matched(2) {} // The first delimiter has no leading CRLF: pretend it was seen
+
+bool MultipartScanner::emit(std::string_view data, const DataFn& on_data) {
+    if (data.empty() || m_state != State::Body || !m_inFile) return true;
+    return on_data(data);
+}
+
+bool MultipartScanner::parsePartHeaders() {
+    std::string_view headers = m_pending;
+    bool is_file = false;
+    std::string content_type;
+    while (!headers.empty()) {
+        auto eol = headers.find("\r\n");
+        std::string_view line = headers.substr(0, eol);
+        auto colon = line.find(':');
+        if (colon != std::string_view::npos) {
+            std::string name = toLower(StringUtils::trim(line.substr(0, colon)));
+            std::string_view value = StringUtils::trim(line.substr(colon + 1));
+            if (name == "content-disposition") {
+                is_file = !headerParam(value, "filename").empty();
+            } else if (name == "content-type") {
+                content_type = std::string(value);
+            }
+        }
+        if (eol == std::string_view::npos) break;
+        headers.remove_prefix(eol + 2);
+    }
+
+    // Only the first file part is stored; form fields and further files are skipped
+    m_inFile = is_file && !m_foundFile;
+    if (m_inFile) {
+        m_foundFile = true;
+        m_partContentType = content_type.empty() ? "application/octet-stream" : content_type;
+    }
+    return true;
+}
+
+bool MultipartScanner::feed(std::string_view chunk, const DataFn& on_data) {
+    const std::string_view delimiter = m_delimiter;
+
+    while (!chunk.empty() && m_state != State::Done) {
+        switch (m_state) {
+        case State::Preamble:
+        case State::Body: {
+            // Continue a delimiter prefix left over from the previous chunk
+            if (m_matched > 0) {
+                std::string_view rest = delimiter.substr(m_matched);
+                std::size_t n = std::min(rest.size(), chunk.size());
+                if (chunk.substr(0, n) == rest.substr(0, n)) {
+                    m_matched += n;
+                    chunk.remove_prefix(n);
+                    if (m_matched == delimiter.size()) {
+                        m_matched = 0;
+                        m_inFile = false;
+                        m_state = State::AfterDelimiter;
+                    }
+                    continue;
+                }
+                // Not a delimiter after all: the carried bytes were payload. CR only
+                // occurs at the start of the delimiter, so no match can begin inside them.
+                if (!emit(delimiter.substr(0, m_matched), on_data)) return false;
+                m_matched = 0;
+            }
+
+            auto pos = chunk.find(delimiter);
+            if (pos != std::string_view::npos) {
+                if (!emit(chunk.substr(0, pos), on_data)) return false;
+                chunk.remove_prefix(pos + delimiter.size());
+                m_inFile = false;
+                m_state = State::AfterDelimiter;
+                continue;
+            }
+
+            // Hold back a trailing delimiter prefix, emit everything before it
+            std::size_t keep = 0;
+            auto cr = chunk.rfind('\r');
+            if (cr != std::string_view::npos && chunk.size() - cr < delimiter.size() &&
+                delimiter.starts_with(chunk.substr(cr))) {
+                keep = chunk.size() - cr;
+            }
+            if (!emit(chunk.substr(0, chunk.size() - keep), on_data)) return false;
+            m_matched = keep;
+            chunk = {};
+            break;
+        }
+        case State::AfterDelimiter: {
+            // "--" closes the body, CRLF starts the headers of the next part
+            while (!chunk.empty() && m_pending.size() < 2) {
+                m_pending.push_back(chunk.front());
+                chunk.remove_prefix(1);
+            }
+            if (m_pending.size() < 2) break;
+            if (m_pending == "--") {
+                m_state = State::Done;
+            } else if (m_pending == "\r\n") {
+                m_state = State::Headers;
+            } else {
+                return false;
+            }
+            m_pending.clear();
+            break;
+        }
+        case State::Headers: {
+            std::size_t searched = m_pending.size() >= 3 ? m_pending.size() - 3 : 0;
+            std::size_t take = std::min(chunk.size(), MAX_PART_HEADERS + 4 - m_pending.size());
+            m_pending.append(chunk.substr(0, take));
+            auto end = m_pending.find("\r\n\r\n", searched);
+            if (end == std::string::npos) {
+                if (m_pending.size() > MAX_PART_HEADERS) return false;
+                chunk.remove_prefix(take);
+                break;
+            }
+            std::size_t consumed = end + 4 - (m_pending.size() - take);
+            chunk.remove_prefix(consumed);
+            m_pending.resize(end);
+            parsePartHeaders();
+            m_pending.clear();
+            m_state = State::Body;
+            break;
+        }
+        case State::Done:
+            break;
+        }
+    }
+    return true;
+}
+
+// --- UploadSink ---
+
+void UploadSink::ShaDeleter::operator()(evp_md_ctx_st* ctx) const {
+    EVP_MD_CTX_free(ctx);
+}
+
+std::expected<std::unique_ptr<UploadSink>, std::string> UploadSink::create(std::string_view content_type,
+                                                                          std::uint64_t content_length) {
+    std::string tmpl = (g_directory / ".tmp" / "upload-XXXXXX").string();
+    int fd = ::mkostemp(tmpl.data(), O_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected("Cannot create upload temp file: " + std::string(std::strerror(errno)));
+    }
+
+    std::unique_ptr<UploadSink> sink(new UploadSink(fd, tmpl, std::string(content_type), g_maxBytes));
+    if (content_length != UINT64_MAX && content_length > g_maxBytes + (sink->m_multipart ? MULTIPART_OVERHEAD : 0)) {
+        // Announced too large: rejected with the first body chunk, nothing touches the disk
+        sink->m_tooLarge = true;
+    }
+    return sink;
+}
+
+UploadSink::UploadSink(int fd, std::filesystem::path temp_path, std::string content_type, std::uint64_t limit)
+    : m_fd(fd),
+      m_tempPath(std::move(temp_path)),
+      m_contentType(std::move(content_type)),
+      m_sha(EVP_MD_CTX_new()),
+      m_limit(limit) {
+    EVP_DigestInit_ex(m_sha.get(), EVP_sha256(), nullptr);
+
+    if (toLower(m_contentType).starts_with("multipart/form-data")) {
+        std::string boundary = headerParam(m_contentType, "boundary");
+        if (boundary.empty() || boundary.size() > 70) {
+            m_malformed = true;
+            m_error = "Missing or invalid multipart boundary";
+        } else {
+            m_multipart = std::make_unique<MultipartScanner>(boundary);
+        }
+    }
+}
+
+UploadSink::~UploadSink() {
+    if (m_fd >= 0) ::close(m_fd);
+    if (!m_committed) {
+        std::error_code ec;
+        std::filesystem::remove(m_tempPath, ec);
+    }
+}
+
+bool UploadSink::append(std::string_view data) {
+    if (m_written + data.size() > m_limit) {
+        m_tooLarge = true;
+        return false;
+    }
+    EVP_DigestUpdate(m_sha.get(), data.data(), data.size());
+    while (!data.empty()) {
+        ssize_t n = ::write(m_fd, data.data(), data.size());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            m_error = "Write failed: " + std::string(std::strerror(errno));
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(n));
+        m_written += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+void UploadSink::write(const char* data, std::size_t length) {
+    if (m_tooLarge || m_malformed || !m_error.empty()) return;
+
+    m_received += length;
+    if (m_received > m_limit + (m_multipart ? MULTIPART_OVERHEAD : 0)) {
+        m_tooLarge = true;
+        return;
+    }
+
+    std::string_view chunk(data, length);
+    if (!m_multipart) {
+        append(chunk);
+        return;
+    }
+    if (!m_multipart->feed(chunk, [this](std::string_view part) { return append(part); }) &&
+        !m_tooLarge && m_error.empty()) {
+        m_malformed = true;
+        m_error = "Malformed multipart body";
+    }
+}
+
+std::expected<UploadResult, std::string> UploadSink::commit(std::string_view name) {
+    if (m_tooLarge) {
+        return std::unexpected("Upload exceeds " + std::to_string(m_limit) + " bytes");
+    }
+    if (!m_error.empty()) {
+        return std::unexpected(m_error);
+    }
+    if (m_multipart && (!m_multipart->done() || !m_multipart->foundFile())) {
+        m_malformed = true;
+        return std::unexpected(m_multipart->foundFile() ? "Incomplete multipart body" : "No file part in multipart body");
+    }
+
+    if (::fdatasync(m_fd) != 0) {
+        return std::unexpected("fdatasync failed: " + std::string(std::strerror(errno)));
+    }
+    ::close(m_fd);
+    m_fd = -1;
+
+    UploadResult result;
+    result.name = std::string(name);
+    result.path = g_directory / result.name;
+    result.size = m_written;
+    result.sha256 = sha256Hex(m_sha.get());
+    if (m_multipart) {
+        result.content_type = m_multipart->partContentType();
+    } else {
+        result.content_type = m_contentType.empty() ? "application/octet-stream" : m_contentType;
+    }
+
+    // Readers only ever see the complete file
+    std::error_code ec;
+    std::filesystem::rename(m_tempPath, result.path, ec);
+    if (ec) {
+        return std::unexpected("Cannot publish upload: " + ec.message());
+    }
+    m_committed = true;
+    return result;
+}
+
+// --- UploadStream ---
+
+std::expected<void, std::string> UploadStream::configure() {
+    auto& config = AppConfig::getInstance();
+    g_directory = config.getString("UPLOAD_DIR", "./data/uploads");
+    std::string max_bytes = config.getString("UPLOAD_MAX_BYTES", "104857600");
+    g_maxBytes = std::strtoull(max_bytes.c_str(), nullptr, 10);
+
+    std::error_code ec;
+    const auto temp_dir = g_directory / ".tmp";
+    std::filesystem::create_directories(temp_dir, ec);
+    if (ec) {
+        return std::unexpected("Cannot create " + temp_dir.string() + ": " + ec.message());
+    }
+    // Bodies of uploads interrupted by a crash or restart
+    for (const auto& entry : std::filesystem::directory_iterator(temp_dir, ec)) {
+        std::filesystem::remove(entry.path(), ec);
+    }
+
+    spdlog::info("Uploads: {} (max {} bytes, {})", g_directory.string(), g_maxBytes,
+                 streaming() ? "streamed to disk" : "buffered by Crow");
+    return {};
+}
+
+bool UploadStream::streaming() {
+#ifdef RZ_HAVE_UPLOAD_STREAM
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool UploadStream::isValidName(std::string_view name) {
+    return !name.empty() && name.size() <= 255 && name.front() != '.' &&
+           name.find_first_of(std::string_view("/\\\0", 3)) == std::string_view::npos;
+}
+
+const std::filesystem::path& UploadStream::directory() {
+    return g_directory;
+}
+
+std::uint64_t UploadStream::maxBytes() {
+    return g_maxBytes;
+}
+
+// --- Crow parser hooks ---
+
+namespace {
+
+struct ParserState {
+    std::string url;
+    std::string field;
+    std::string content_type;
+    bool in_headers = false;
+    bool in_value = false;
+    bool capture = false; // Current header is Content-Type
+    std::unique_ptr<UploadSink> sink;
+};
+
+thread_local std::unordered_map<const void*, ParserState> t_parsers;
+thread_local std::unique_ptr<UploadSink> t_completed;
+thread_local std::string t_rejection;
+
+} // namespace
+
+std::unique_ptr<UploadSink> UploadStream::take() {
+    return std::move(t_completed);
+}
+
+namespace upload_hooks {
+
+void onUrl(const void* parser, const char* at, std::size_t length) {
+    std::string_view fragment(at, length);
+    auto it = t_parsers.find(parser);
+    if (it == t_parsers.end()) {
+        // Only track URLs that can still turn into an upload URL
+        std::size_t n = std::min(fragment.size(), UPLOAD_PREFIX.size());
+        if (fragment.substr(0, n) != UPLOAD_PREFIX.substr(0, n)) return;
+        it = t_parsers.emplace(parser, ParserState{}).first;
+    } else if (it->second.in_headers || it->second.sink) {
+        // Left over from a connection that died mid-request at the same address
+        it->second = ParserState{};
+    }
+    it->second.url.append(fragment);
+}
+
+void onHeaderField(const void* parser, const char* at, std::size_t length) {
+    if (t_parsers.empty()) return;
+    auto it = t_parsers.find(parser);
+    if (it == t_parsers.end()) return;
+    auto& state = it->second;
+    if (state.in_value) {
+        state.in_value = false;
+        state.field.clear();
+    }
+    state.in_headers = true;
+    state.field.append(at, length);
+}
+
+void onHeaderValue(const void* parser, const char* at, std::size_t length) {
+    if (t_parsers.empty()) return;
+    auto it = t_parsers.find(parser);
+    if (it == t_parsers.end()) return;
+    auto& state = it->second;
+    if (!state.in_value) {
+        state.in_value = true;
+        state.capture = toLower(state.field) == "content-type";
+        if (state.capture) state.content_type.clear();
+    }
+    if (state.capture) state.content_type.append(at, length);
+}
+
+void onHeadersComplete(const void* parser, unsigned int method, std::uint64_t content_length) {
+    if (t_parsers.empty()) return;
+    auto it = t_parsers.find(parser);
+    if (it == t_parsers.end()) return;
+    auto& state = it->second;
+
+    const bool is_upload = std::string_view(state.url).starts_with(UPLOAD_PREFIX) &&
+                           (method == static_cast<unsigned int>(crow::HTTPMethod::Post) ||
+                            method == static_cast<unsigned int>(crow::HTTPMethod::Put));
+    if (!is_upload) {
+        t_parsers.erase(it);
+        return;
+    }
+
+    auto sink = UploadSink::create(StringUtils::trim(state.content_type), content_length);
+    if (!sink) {
+        // Falls back to the buffered body; the handler reports the same error
+        spdlog::error("Upload {}: {}", state.url, sink.error());
+        t_parsers.erase(it);
+        return;
+    }
+    state.sink = std::move(*sink);
+}
+
+int onBody(const void* parser, const char* at, std::size_t length) {
+    if (t_parsers.empty()) return 0;
+    auto it = t_parsers.find(parser);
+    if (it == t_parsers.end() || !it->second.sink) return 0;
+    it->second.sink->write(at, length);
+    if (!it->second.sink->tooLarge()) return 1;
+
+    // Answer now instead of reading the rest; the sink removes its temp file
+    std::string body = "Upload exceeds " + std::to_string(g_maxBytes) + " bytes";
+    t_rejection = "HTTP/1.1 413 Content Too Large\r\nContent-Type: text/plain\r\nContent-Length: " +
+                  std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    spdlog::warn("Upload {}: {}", it->second.url, body);
+    t_parsers.erase(it);
+    return -1;
+}
+
+void onMessageComplete(const void* parser) {
+    // The route handler runs synchronously right after this callback on the
+    // same thread; a sink it did not take is dropped with the next message.
+    t_completed.reset();
+    if (t_parsers.empty()) return;
+    auto it = t_parsers.find(parser);
+    if (it == t_parsers.end()) return;
+    t_completed = std::move(it->second.sink);
+    t_parsers.erase(it);
+}
+
+void onClose(const void* parser) {
+    // Client went away mid-upload: closes the temp file and removes it
+    if (!t_parsers.empty()) t_parsers.erase(parser);
+}
+
+const std::string& rejection() {
+    return t_rejection;
+}
+
+} // namespace upload_hooks
+
+} // namespace rz::utils
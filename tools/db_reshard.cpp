@@ -0,0 +1,166 @@
+/**
+ * SPDX-FileComment: Database Resharding Tool
+ * SPDX-FileType: SOURCE
+ * SPDX-FileContributor: ZHENG Robert
+ * SPDX-FileCopyrightText: 2026 ZHENG Robert
+ * SPDX-License-Identifier: MIT
+ *
+ * @file db_reshard.cpp
+ * @brief Copies all users from one shard layout into another (server stopped).
+ * @version 0.1.2
+ * @date 2026-10-18
+ *
+ * @author ZHENG Robert (robert@hase-zheng.net)
+ * @copyright Copyright (c) 2026 ZHENG Robert
+ *
+ * @license MIT License
+ *
+ * Usage:
+ *   db_reshard --db ./data/db/app.sqlite --from 1 --to 4 [--batch 1000]
+ *
+ * --db is DB_DIR; --from and --to are the old and the new DB_SHARDS. The
+ * source files are only read. The target files must not exist yet; on any
+ * error they are removed again. Rows are inserted, never replaced, so a UUID
+ * found twice stops the run. E-mail addresses are checked across all sources
+ * in memory (UNIQUE only covers one target file), and a duplicate stops the
+ * run as well. Afterwards, set DB_SHARDS to the new count and delete the old
+ * files once the server runs on the new layout.
+ */
+
+#include "services/database_service.hpp"
+#include "services/db_shard.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using rz::services::DatabaseService;
+using rz::services::DbShard;
+
+using Rows = std::vector<std::pair<rz::services::User, rz::services::NotificationConfig>>;
+
+void removeShardFiles(const std::string& path) {
+    std::error_code ec;
+    for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path + suffix, ec);
+}
+
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " --db PATH --from N --to M [--batch ROWS]\n";
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string db_path;
+    std::size_t from = 0;
+    std::size_t to = 0;
+    std::size_t batch = 1000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view arg = argv[i];
+        if (arg == "--db") db_path = argv[i + 1];
+        else if (arg == "--from") from = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (arg == "--to") to = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (arg == "--batch") batch = std::max<std::size_t>(1, std::strtoull(argv[i + 1], nullptr, 10));
+        else return usage(argv[0]);
+    }
+    if (db_path.empty() || from == 0 || to == 0 || argc % 2 == 0) return usage(argv[0]);
+    if (from == to) {
+        std::cerr << "Source and target layout are the same\n";
+        return 2;
+    }
+
+    std::vector<std::string> target_paths;
+    for (std::size_t i = 0; i < to; ++i) {
+        target_paths.push_back(DatabaseService::shardPath(db_path, i, to));
+        if (std::filesystem::exists(target_paths.back())) {
+            std::cerr << target_paths.back() << " already exists\n";
+            return 1;
+        }
+    }
+
+    std::vector<std::unique_ptr<DbShard>> sources;
+    for (std::size_t i = 0; i < from; ++i) {
+        DbShard::Options options{.index = i, .count = from, .readers = 0, .read_only = true};
+        auto shard = DbShard::open(DatabaseService::shardPath(db_path, i, from), options);
+        if (!shard) {
+            std::cerr << shard.error() << "\n";
+            return 1;
+        }
+        sources.push_back(std::move(*shard));
+    }
+
+    std::vector<std::unique_ptr<DbShard>> targets;
+    auto fail = [&](const std::string& error) {
+        std::cerr << error << "\n";
+        targets.clear(); // Close before removing
+        for (const auto& path : target_paths) removeShardFiles(path);
+        return 1;
+    };
+    for (std::size_t i = 0; i < to; ++i) {
+        DbShard::Options options{.index = i, .count = to, .readers = 0};
+        auto shard = DbShard::open(target_paths[i], options);
+        if (!shard) return fail(shard.error());
+        targets.push_back(std::move(*shard));
+    }
+
+    // Rows are buffered per target shard and written in one transaction per batch
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Rows> pending(to);
+    std::string error;
+    auto flush = [&](std::size_t target) {
+        if (pending[target].empty() || !error.empty()) return;
+        if (auto res = targets[target]->insert(pending[target]); !res) {
+            error = std::format("{}: {}", target_paths[target], res.error());
+            return;
+        }
+        pending[target].clear();
+    };
+
+    // E-mail address -> UUID over all sources; duplicates hashing to different targets pass UNIQUE
+    std::unordered_map<std::string, std::string> emails;
+    std::size_t read = 0;
+    for (auto& source : sources) {
+        auto rows = source->forEach([&](const rz::services::User& user, const rz::services::NotificationConfig& config) {
+            if (!error.empty()) return;
+            if (auto [it, inserted] = emails.emplace(user.email, user.uuid); !inserted) {
+                error = std::format("E-mail address {} is held by users {} and {}", user.email, it->second, user.uuid);
+                return;
+            }
+            std::size_t target = DatabaseService::shardFor(user.uuid, to);
+            pending[target].emplace_back(user, config);
+            if (pending[target].size() >= batch) flush(target);
+        });
+        if (!rows) return fail(std::format("{}: {}", source->path(), rows.error()));
+        if (!error.empty()) return fail(error);
+        read += *rows;
+        std::cout << std::format("{}: {} users\n", source->path(), *rows);
+    }
+    for (std::size_t i = 0; i < to; ++i) flush(i);
+    if (!error.empty()) return fail(error);
+
+    // Count what the files hold, not what was handed to them
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < to; ++i) {
+        auto rows = targets[i]->count();
+        if (!rows) return fail(rows.error());
+        std::cout << std::format("{}: {} users\n", target_paths[i], *rows);
+        total += *rows;
+    }
+    if (total != read) return fail(std::format("Read {} users but the new shards hold {}", read, total));
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::format("Resharded {} users from {} to {} shards in {:.2f} s. Set DB_SHARDS={}.\n", total, from,
+                             to, elapsed, to);
+    return 0;
+}